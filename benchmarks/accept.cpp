@@ -0,0 +1,81 @@
+#include <chrono>
+#include <cstddef>
+#include <vector>
+
+#include "bench.hpp"
+#include "pposix/address.hpp"
+#include "pposix/lnx/epoll.hpp"
+#include "pposix/socket.hpp"
+
+namespace pposix::bench {
+
+namespace {
+
+constexpr std::size_t connections_per_round{64u};
+
+socket tcp_socket(const socket_flag flags) {
+  return check(socket::unsafe_make(socket_domain::inet, socket_type::stream, flags,
+                                   socket_protocol::tcp),
+               "socket");
+}
+
+}  // namespace
+
+// A loopback connect storm of 64 clients per round against a non-blocking listener watched by
+// epoll: one accept per readiness event against drain_accept, which accepts until EAGAIN. Clients
+// close with a zero linger so no TIME_WAIT state piles up. Only the accepting side is timed, from
+// the first epoll_wait to the last accept; the time is per connection accepted.
+void accept_storm() {
+  socket listener{tcp_socket(socket_flag::closexec | socket_flag::nonblock)};
+  check(listener.bind(inet_address::loopback(0u)), "bind");
+  check(listener.listen(1024), "listen");
+  const auto address{check(listener.local_address(), "getsockname")};
+  const raw_fd listener_fd{static_cast<raw_fd_t>(listener.fd())};
+
+  auto ep{check(lnx::epoll::create(lnx::epoll_cloexec), "epoll_create1")};
+  const lnx::capi::epoll_event readable{lnx::capi::epoll_event_flag::read_available};
+  check(ep.ctl(lnx::epoll_add{listener_fd, readable}), "epoll_ctl");
+  lnx::epoll_event events[1];
+
+  std::vector<socket> clients(connections_per_round);
+  const auto run = [&](const char *variant, auto &&accept_ready) {
+    std::chrono::steady_clock::duration accepting{};
+    std::size_t accepted{0u};
+    nanoseconds_per_operation(connections_per_round, [&]() {
+      for (socket &client : clients) {
+        client = tcp_socket(socket_flag::closexec);
+        check(client.setsockopt(socket_linger{true, seconds{0}}), "SO_LINGER");
+        check(client.connect(address), "connect");
+      }
+
+      const auto start{std::chrono::steady_clock::now()};
+      for (std::size_t round_accepted{0u}; round_accepted < connections_per_round;) {
+        check(ep.wait(events, milliseconds{-1}), "epoll_wait");
+        round_accepted += accept_ready();
+      }
+
+      accepting += std::chrono::steady_clock::now() - start;
+      accepted += connections_per_round;
+
+      for (socket &client : clients) {
+        client = socket{};
+      }
+    });
+
+    report("accept", variant,
+           static_cast<double>(std::chrono::duration_cast<nanoseconds>(accepting).count()) /
+               static_cast<double>(accepted));
+  };
+
+  run("accept per epoll_wait", [&]() -> std::size_t {
+    check(listener.accept(socket_flag::closexec | socket_flag::nonblock), "accept");
+    return 1u;
+  });
+
+  run("drain_accept per epoll_wait", [&]() {
+    const auto flags{socket_flag::closexec | socket_flag::nonblock};
+    return check(drain_accept(listener, flags, [](socket) noexcept {}), "accept");
+  });
+}
+
+}  // namespace pposix::bench
@@ -0,0 +1,84 @@
+#include "bench.hpp"
+
+#include <stdlib.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <vector>
+
+#include "pposix/address.hpp"
+#include "pposix/errno.hpp"
+
+namespace pposix::bench {
+
+file temporary_file(const std::size_t size) {
+  char path[]{"/tmp/pposix_bench_XXXXXX"};
+  const int fd{::mkstemp(path)};
+  if (fd < 0) {
+    check(current_errno_code(), "mkstemp");
+  }
+
+  ::unlink(path);
+  file f{raw_fd{fd}};
+
+  const std::vector<std::byte> chunk(64u * 1024u);
+  for (std::size_t written{0u}; written < size;) {
+    const ssize_t n{::write(fd, chunk.data(), std::min(chunk.size(), size - written))};
+    if (n < 0) {
+      check(current_errno_code(), "write");
+    }
+
+    written += static_cast<std::size_t>(n);
+  }
+
+  return f;
+}
+
+std::pair<socket, socket> tcp_pair() {
+  socket listener{check(socket::unsafe_make(socket_domain::inet, socket_type::stream,
+                                            socket_flag::closexec, socket_protocol::tcp),
+                        "socket")};
+  check(listener.bind(inet_address::loopback(0u)), "bind");
+  check(listener.listen(1), "listen");
+
+  socket client{check(socket::unsafe_make(socket_domain::inet, socket_type::stream,
+                                          socket_flag::closexec, socket_protocol::tcp),
+                      "socket")};
+  check(client.connect(check(listener.local_address(), "getsockname")), "connect");
+  socket server{check(listener.accept(socket_flag::closexec), "accept")};
+  return {std::move(client), std::move(server)};
+}
+
+void receive_bytes(socket &s, std::size_t bytes) {
+  static std::byte sink[64u * 1024u];
+  byte_span buffers[]{sink};
+  while (bytes > 0u) {
+    buffers[0] = byte_span{sink, std::min(sizeof(sink), bytes)};
+    const auto received{check(s.recvmsg(buffers, message_flag::none), "recvmsg")};
+    if (received.bytes() == 0u) {
+      check(make_errno_code(std::errc::connection_reset), "recvmsg");
+    }
+
+    bytes -= received.bytes();
+  }
+}
+
+void report_percentiles(const char *benchmark, const char *variant,
+                        std::vector<nanoseconds> &samples) {
+  if (samples.empty()) {
+    return;
+  }
+
+  std::sort(samples.begin(), samples.end());
+  const auto at = [&](const double fraction) {
+    const double last{static_cast<double>(samples.size() - 1u)};
+    const auto index{static_cast<std::size_t>(fraction * last)};
+    return static_cast<double>(samples[index].count()) / 1000.0;
+  };
+
+  std::printf("%-16s %-32s p50 %8.1f us  p99 %8.1f us  p999 %8.1f us\n", benchmark, variant,
+              at(0.5), at(0.99), at(0.999));
+}
+
+}  // namespace pposix::bench
@@ -0,0 +1,111 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+#include <system_error>
+#include <utility>
+#include <vector>
+
+#include "pposix/duration.hpp"
+#include "pposix/file.hpp"
+#include "pposix/result.hpp"
+#include "pposix/socket.hpp"
+
+namespace pposix::bench {
+
+// Stop on a failed call; the benchmarks only measure the success path.
+inline void check(const std::error_code error, const char *what) {
+  if (error) {
+    std::fprintf(stderr, "%s: %s\n", what, error.message().c_str());
+    std::exit(EXIT_FAILURE);
+  }
+}
+
+template <class T>
+T check(result<T> res, const char *what) {
+  if (not res) {
+    check(res.error(), what);
+  }
+
+  return std::move(*res);
+}
+
+// Call round() until at least 200 ms have passed and return the mean time of one of the
+// operations_per_round operations it performs.
+template <class Round>
+double nanoseconds_per_operation(const std::size_t operations_per_round, Round &&round) {
+  using clock = std::chrono::steady_clock;
+  constexpr auto min_duration{std::chrono::milliseconds{200}};
+
+  // Warm up caches and the kernel's lazily set up state first.
+  for (int i{0}; i < 16; ++i) {
+    round();
+  }
+
+  std::size_t rounds{0u};
+  const auto start{clock::now()};
+  auto elapsed{clock::duration{}};
+  do {
+    for (int i{0}; i < 16; ++i) {
+      round();
+    }
+
+    rounds += 16u;
+    elapsed = clock::now() - start;
+  } while (elapsed < min_duration);
+
+  const auto nanoseconds{std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed)};
+  return static_cast<double>(nanoseconds.count()) /
+         static_cast<double>(rounds * operations_per_round);
+}
+
+// A page cached file of size bytes in /tmp, removed as soon as it is opened.
+file temporary_file(std::size_t size);
+
+// Both ends of a blocking TCP connection over loopback: the connecting socket, then the accepted
+// one.
+std::pair<socket, socket> tcp_pair();
+
+// Read and discard exactly bytes bytes from a blocking stream socket.
+void receive_bytes(socket &s, std::size_t bytes);
+
+// Print one line per variant: the benchmark, the variant and its cost per operation.
+inline void report(const char *benchmark, const char *variant, const double nanoseconds) {
+  std::printf("%-16s %-32s %10.1f ns/op\n", benchmark, variant, nanoseconds);
+}
+
+// Print one line with the median, 99th and 99.9th percentile of the samples, which are sorted in
+// place, for benchmarks where the tail matters more than the mean.
+void report_percentiles(const char *benchmark, const char *variant,
+                        std::vector<nanoseconds> &samples);
+
+// Each benchmark compares the plain system calls a caller would otherwise make (the "before")
+// with the pposix facility for the same work (the "after").
+void io_uring_reads();
+void epoll_updates();
+void epoll_wakeup_jitter();
+void reactor_dispatch();
+void reactor_group_accepts();
+void timer_churn();
+void ping_pong_latency();
+#if PPOSIX_COROUTINES_ENABLED
+void coroutine_wakeups();
+#endif
+void gather_sends();
+void datagram_batches();
+void zerocopy_sends();
+void request_latency();
+void reuseport_spread();
+void accept_storm();
+void profile_apply();
+void tcp_info_sampling();
+void udp_segmentation();
+void file_to_socket();
+void fd_handoff();
+void task_posting();
+void packet_capture();
+void mapped_scan();
+
+}  // namespace pposix::bench
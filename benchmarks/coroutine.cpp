@@ -0,0 +1,129 @@
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <system_error>
+
+#include "bench.hpp"
+#include "pposix/errno.hpp"
+#include "pposix/lnx/coroutine.hpp"
+#include "pposix/lnx/eventfd.hpp"
+#include "pposix/lnx/timer_wheel.hpp"
+
+namespace pposix::bench {
+
+namespace {
+
+class eventfd_reader final : public lnx::reactor_handler {
+ public:
+  explicit eventfd_reader(lnx::eventfd &e) noexcept : eventfd_{&e} {}
+
+  void on_read() noexcept override {
+    if (eventfd_->read()) {
+      ++count_;
+    }
+  }
+
+  uint64_t count() const noexcept { return count_; }
+
+ private:
+  lnx::eventfd *eventfd_;
+  uint64_t count_{0u};
+};
+
+// Await the eventfd and read it until stop is set, then return the number of reads.
+lnx::task<uint64_t> read_until_stopped(lnx::reactor &r, lnx::eventfd &e, const bool &stop,
+                                       uint64_t &count) {
+  while (not stop) {
+    if (const auto error = co_await lnx::readable(r, e.fd())) {
+      break;
+    }
+
+    if (e.read()) {
+      ++count;
+    }
+  }
+
+  co_return count;
+}
+
+lnx::task<void> run_reader(lnx::reactor &r, lnx::eventfd &e, const bool &stop, uint64_t &count,
+                           uint64_t &result) {
+  result = co_await read_until_stopped(r, e, stop, count);
+}
+
+lnx::task<void> sleep_until_stopped(lnx::timer_wheel &wheel, const nanoseconds delay,
+                                    const bool &stop, uint64_t &count) {
+  while (not stop) {
+    if (const auto error = co_await lnx::sleep_for(wheel, delay)) {
+      break;
+    }
+
+    ++count;
+  }
+}
+
+}  // namespace
+
+// Waking up on an eventfd written once per round on the same thread: a reactor_handler registered
+// once against a spawned task that co_awaits readable, which registers the descriptor for each
+// await and removes it when the event fires. The time is per wakeup. Also the period of a
+// coroutine that co_awaits sleep_for(100 us) on a timer_wheel with a 100 us tick.
+void coroutine_wakeups() {
+  auto r{check(lnx::reactor::create(4u), "reactor")};
+  auto e{check(lnx::eventfd::create(0u, lnx::eventfd_cloexec | lnx::eventfd_nonblock), "eventfd")};
+
+  {
+    eventfd_reader reader{e};
+    check(r.add(e.fd(), lnx::epoll_read_available, reader), "epoll_ctl");
+    report("coroutine", "reactor_handler", nanoseconds_per_operation(1u, [&]() {
+             check(e.write(1u), "write (eventfd)");
+             check(r.run_once(milliseconds{0}), "run_once");
+           }));
+    check(r.remove(e.fd()), "epoll_ctl");
+  }
+
+  {
+    bool stop{false};
+    uint64_t count{0u};
+    uint64_t result{0u};
+    lnx::spawn(run_reader(r, e, stop, count, result));
+    report("coroutine", "co_await readable", nanoseconds_per_operation(1u, [&]() {
+             const uint64_t before{count};
+             check(e.write(1u), "write (eventfd)");
+             check(r.run_once(milliseconds{0}), "run_once");
+             if (count == before) {
+               check(make_errno_code(std::errc::io_error), "co_await readable");
+             }
+           }));
+
+    stop = true;
+    check(e.write(1u), "write (eventfd)");
+    check(r.run_once(milliseconds{0}), "run_once");
+    if (result != count) {
+      std::fprintf(stderr, "coroutine: task returned %llu of %llu reads\n",
+                   static_cast<unsigned long long>(result),
+                   static_cast<unsigned long long>(count));
+    }
+  }
+
+  constexpr nanoseconds delay{std::chrono::microseconds{100}};
+  auto wheel{check(lnx::timer_wheel::create(delay), "timer_wheel")};
+  check(wheel.attach(r), "epoll_ctl");
+
+  bool stop{false};
+  uint64_t sleeps{0u};
+  lnx::spawn(sleep_until_stopped(wheel, delay, stop, sleeps));
+  report("coroutine", "co_await sleep_for(100 us)", nanoseconds_per_operation(1u, [&]() {
+           for (const uint64_t before{sleeps}; sleeps == before;) {
+             check(r.run_once(milliseconds{-1}), "run_once");
+           }
+         }));
+
+  stop = true;
+  while (wheel.size() != 0u) {
+    check(r.run_once(milliseconds{-1}), "run_once");
+  }
+}
+
+}  // namespace pposix::bench
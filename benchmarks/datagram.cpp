@@ -0,0 +1,74 @@
+#include <cstddef>
+
+#include "bench.hpp"
+#include "pposix/address.hpp"
+#include "pposix/socket.hpp"
+
+namespace pposix::bench {
+
+namespace {
+
+constexpr std::size_t batch_size{32u};
+
+socket udp_socket() {
+  return check(socket::unsafe_make(socket_domain::inet, socket_type::dgram, socket_flag::closexec,
+                                   socket_protocol::udp),
+               "socket");
+}
+
+}  // namespace
+
+// 64 byte UDP datagrams over loopback, 32 per round: one sendmsg and one recvmsg per datagram
+// against one sendmmsg and one recvmmsg per round. The time is per datagram sent and received.
+void datagram_batches() {
+  socket receiver{udp_socket()};
+  check(receiver.bind(inet_address::loopback(0u)), "bind");
+  socket sender{udp_socket()};
+  check(sender.connect(check(receiver.local_address(), "getsockname")), "connect");
+
+  std::byte payload[64]{};
+  const byte_cspan send_buffers[]{payload};
+  std::byte received[batch_size][64];
+  byte_span receive_buffers[batch_size];
+  for (std::size_t i{0u}; i < batch_size; ++i) {
+    receive_buffers[i] = byte_span{received[i]};
+  }
+
+  report("datagram", "sendmsg + recvmsg", nanoseconds_per_operation(batch_size, [&]() {
+           for (std::size_t i{0u}; i < batch_size; ++i) {
+             check(sender.sendmsg(send_buffers, message_flag::none), "sendmsg");
+           }
+
+           for (std::size_t i{0u}; i < batch_size; ++i) {
+             check(receiver.recvmsg(span<byte_span>{receive_buffers + i, 1u}, message_flag::none),
+                   "recvmsg");
+           }
+         }));
+
+  batch_message sends[batch_size];
+  batch_message receives[batch_size];
+  for (std::size_t i{0u}; i < batch_size; ++i) {
+    sends[i].set_buffers(cspan<byte_cspan>{send_buffers});
+    receives[i].set_buffers(span<byte_span>{receive_buffers + i, 1u});
+  }
+
+  report("datagram", "send_batch + recv_batch", nanoseconds_per_operation(batch_size, [&]() {
+           std::size_t sent{0u};
+           while (sent < batch_size) {
+             sent += check(sender.send_batch(span<batch_message>{sends + sent, batch_size - sent},
+                                             message_flag::none),
+                           "sendmmsg");
+           }
+
+           std::size_t received_count{0u};
+           while (received_count < batch_size) {
+             received_count += check(
+                 receiver.recv_batch(
+                     span<batch_message>{receives + received_count, batch_size - received_count},
+                     message_flag::none),
+                 "recvmmsg");
+           }
+         }));
+}
+
+}  // namespace pposix::bench
@@ -0,0 +1,125 @@
+#include <sys/prctl.h>
+
+#include <chrono>
+#include <cstddef>
+#include <vector>
+
+#include "bench.hpp"
+#include "pposix/errno.hpp"
+#include "pposix/lnx/epoll.hpp"
+#include "pposix/lnx/pipe.hpp"
+#include "pposix/signal.hpp"
+
+namespace pposix::bench {
+
+namespace {
+
+constexpr std::size_t fd_count{64u};
+constexpr std::size_t wakeup_count{2000u};
+
+}  // namespace
+
+// Interest list updates for 64 registered descriptors, applied with one epoll_ctl each against
+// recorded with defer_ctl and applied by flush. "toggle" turns write interest on and off again
+// within a tick, as a writer does when its buffer fills and drains; "change" turns it on in one
+// tick and off in the next, which coalescing cannot save.
+void epoll_updates() {
+  std::vector<lnx::pipe> pipes{};
+  for (std::size_t i{0u}; i < fd_count; ++i) {
+    pipes.push_back(check(lnx::pipe::create(lnx::pipe_flag::cloexec), "pipe2"));
+  }
+
+  auto direct{check(lnx::epoll::create(lnx::epoll_cloexec), "epoll_create1")};
+  auto deferred{check(lnx::epoll::create(lnx::epoll_cloexec), "epoll_create1")};
+  for (const lnx::pipe &p : pipes) {
+    const lnx::capi::epoll_event event{lnx::capi::epoll_event_flag::read_available};
+    check(direct.ctl(lnx::epoll_add{p.read_fd(), event}), "epoll_ctl");
+    check(deferred.defer_ctl(lnx::epoll_add{p.read_fd(), event}), "defer_ctl");
+  }
+
+  check(deferred.flush(), "flush");
+
+  const auto write_on = [](const lnx::pipe &p) {
+    return lnx::epoll_modify{p.read_fd(), lnx::epoll_read_available | lnx::epoll_write_available};
+  };
+  const auto write_off = [](const lnx::pipe &p) {
+    return lnx::epoll_modify{p.read_fd(), lnx::epoll_read_available};
+  };
+
+  report("epoll", "ctl, toggle", nanoseconds_per_operation(2u * fd_count, [&]() {
+           for (const lnx::pipe &p : pipes) {
+             check(direct.ctl(write_on(p)), "epoll_ctl");
+             check(direct.ctl(write_off(p)), "epoll_ctl");
+           }
+         }));
+
+  report("epoll", "defer_ctl + flush, toggle", nanoseconds_per_operation(2u * fd_count, [&]() {
+           for (const lnx::pipe &p : pipes) {
+             check(deferred.defer_ctl(write_on(p)), "defer_ctl");
+             check(deferred.defer_ctl(write_off(p)), "defer_ctl");
+           }
+
+           check(deferred.flush(), "flush");
+         }));
+
+  bool on{false};
+  report("epoll", "ctl, change", nanoseconds_per_operation(fd_count, [&]() {
+           on = not on;
+           for (const lnx::pipe &p : pipes) {
+             check(direct.ctl(on ? write_on(p) : write_off(p)), "epoll_ctl");
+           }
+         }));
+
+  report("epoll", "defer_ctl + flush, change", nanoseconds_per_operation(fd_count, [&]() {
+           on = not on;
+           for (const lnx::pipe &p : pipes) {
+             check(deferred.defer_ctl(on ? write_on(p) : write_off(p)), "defer_ctl");
+           }
+
+           check(deferred.flush(), "flush");
+         }));
+}
+
+// How late a 50 us timeout on an epoll instance with nothing registered wakes up: epoll::pwait2
+// with the default 50 us timer slack and with a 1 ns slack (PR_SET_TIMERSLACK), against the 1 ms
+// wait the millisecond-rounded fallback turns it into. Each sample is the time past 50 us.
+void epoll_wakeup_jitter() {
+  using clock = std::chrono::steady_clock;
+  constexpr nanoseconds timeout{std::chrono::microseconds{50}};
+
+  auto ep{check(lnx::epoll::create(lnx::epoll_cloexec), "epoll_create1")};
+  const sigset mask{};
+  lnx::epoll_event events[1];
+
+  const auto sample = [&](const char *variant, auto &&wait) {
+    std::vector<nanoseconds> late(wakeup_count);
+    for (nanoseconds &l : late) {
+      const auto start{clock::now()};
+      check(wait(), "epoll_pwait");
+      l = std::chrono::duration_cast<nanoseconds>(clock::now() - start) - timeout;
+    }
+
+    report_percentiles("epoll_jitter", variant, late);
+  };
+
+  sample("pwait2, 50 us", [&]() { return ep.pwait2(events, timeout, mask); });
+
+  const int default_slack{::prctl(PR_GET_TIMERSLACK, 0, 0, 0, 0)};
+  if (default_slack < 0) {
+    check(current_errno_code(), "prctl");
+  }
+
+  if (::prctl(PR_SET_TIMERSLACK, 1ul, 0, 0, 0) != 0) {
+    check(current_errno_code(), "prctl");
+  }
+
+  sample("pwait2, 50 us, 1 ns slack", [&]() { return ep.pwait2(events, timeout, mask); });
+
+  if (::prctl(PR_SET_TIMERSLACK, static_cast<unsigned long>(default_slack), 0, 0, 0) != 0) {
+    check(current_errno_code(), "prctl");
+  }
+
+  sample("pwait, rounded up to 1 ms", [&]() { return ep.pwait(events, milliseconds{1}, mask); });
+}
+
+}  // namespace pposix::bench
@@ -0,0 +1,47 @@
+#include <cstddef>
+#include <vector>
+
+#include "bench.hpp"
+#include "pposix/fd_channel.hpp"
+#include "pposix/lnx/pipe.hpp"
+
+namespace pposix::bench {
+
+namespace {
+
+constexpr std::size_t fds_per_round{64u};
+
+}  // namespace
+
+// 64 descriptors handed over a SOCK_SEQPACKET pair per round, one per message against batches of
+// 16 and 64. Each message is received before the next is sent, and the received descriptors are
+// closed when the next batch replaces them. The time is per descriptor.
+void fd_handoff() {
+  auto [sender, receiver] = check(fd_channel::create_pair(socket_flag::closexec), "socketpair");
+  const lnx::pipe p{check(lnx::pipe::create(lnx::pipe_flag::cloexec), "pipe2")};
+
+  const std::vector<raw_fd> fds(fds_per_round, p.read_fd());
+  std::vector<file_descriptor> received(fds_per_round);
+  const std::byte payload[1]{};
+  std::byte received_payload[1];
+
+  for (const std::size_t batch : {std::size_t{1u}, std::size_t{16u}, std::size_t{64u}}) {
+    const auto round = [&]() {
+      for (std::size_t sent{0u}; sent < fds_per_round; sent += batch) {
+        check(sender.send(cspan<raw_fd>{fds.data() + sent, batch}, payload, message_flag::none),
+              "sendmsg (SCM_RIGHTS)");
+        check(receiver.receive(received_payload,
+                               span<file_descriptor>{received.data() + sent, batch},
+                               message_flag::cmsg_cloexec),
+              "recvmsg (SCM_RIGHTS)");
+      }
+    };
+
+    const char *const variant{batch == 1u    ? "1 per message"
+                              : batch == 16u ? "16 per message"
+                                             : "64 per message"};
+    report("fd_channel", variant, nanoseconds_per_operation(fds_per_round, round));
+  }
+}
+
+}  // namespace pposix::bench
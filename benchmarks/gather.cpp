@@ -0,0 +1,49 @@
+#include <cstddef>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+#include "bench.hpp"
+#include "pposix/socket.hpp"
+
+namespace pposix::bench {
+
+namespace {
+
+constexpr std::size_t header_size{16u};
+constexpr std::size_t body_sizes[]{256u, 4096u, 65536u};
+
+}  // namespace
+
+// Messages made of a 16 byte header and a body of 256 B, 4 KiB or 64 KiB sent over a loopback
+// TCP connection and read back on the other end: copying header and body into one buffer and
+// sending that, against gathering both with a single sendmsg. The time is per message.
+void gather_sends() {
+  auto [client, server] = tcp_pair();
+
+  std::byte header[header_size]{};
+  for (const std::size_t body_size : body_sizes) {
+    const std::vector<std::byte> body(body_size);
+    std::vector<std::byte> message(header_size + body_size);
+    const std::size_t message_size{message.size()};
+
+    char variant[64];
+    std::snprintf(variant, sizeof(variant), "copy + sendmsg, %zu B body", body_size);
+    report("gather", variant, nanoseconds_per_operation(1u, [&]() {
+             std::memcpy(message.data(), header, header_size);
+             std::memcpy(message.data() + header_size, body.data(), body_size);
+             const byte_cspan buffers[]{byte_cspan{message.data(), message_size}};
+             check(client.sendmsg(buffers, message_flag::none), "sendmsg");
+             receive_bytes(server, message_size);
+           }));
+
+    std::snprintf(variant, sizeof(variant), "gather sendmsg, %zu B body", body_size);
+    report("gather", variant, nanoseconds_per_operation(1u, [&]() {
+             const byte_cspan buffers[]{header, byte_cspan{body.data(), body_size}};
+             check(client.sendmsg(buffers, message_flag::none), "sendmsg");
+             receive_bytes(server, message_size);
+           }));
+  }
+}
+
+}  // namespace pposix::bench
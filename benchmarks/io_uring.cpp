@@ -0,0 +1,63 @@
+#include <unistd.h>
+
+#include <cstddef>
+#include <vector>
+
+#include "bench.hpp"
+#include "pposix/errno.hpp"
+#include "pposix/file.hpp"
+#include "pposix/lnx/io_uring.hpp"
+
+namespace pposix::bench {
+
+namespace {
+
+constexpr std::size_t block_size{512u};
+constexpr std::size_t block_count{2048u};
+
+}  // namespace
+
+// Reads of 512 byte blocks from a page cached file: one pread per block, against io_uring with one
+// io_uring_enter per batch of reads.
+void io_uring_reads() {
+  const file f{temporary_file(block_size * block_count)};
+  const raw_fd fd{f.fd()};
+  std::vector<std::byte> buffer(block_size * 32u);
+  std::size_t next{0u};
+
+  const auto offset = [&]() { return static_cast<off_t>((next++ % block_count) * block_size); };
+
+  report("io_uring", "pread", nanoseconds_per_operation(32u, [&]() {
+           for (std::size_t i{0u}; i < 32u; ++i) {
+             if (::pread(static_cast<raw_fd_t>(fd), buffer.data() + i * block_size, block_size,
+                         offset()) < 0) {
+               check(current_errno_code(), "pread");
+             }
+           }
+         }));
+
+  auto ring{check(lnx::io_uring::create(64u), "io_uring_setup")};
+  lnx::io_uring_completion completions[32];
+
+  for (const unsigned batch : {1u, 8u, 32u}) {
+    const auto round = [&]() {
+      for (unsigned i{0u}; i < batch; ++i) {
+        check(ring.read(fd, byte_span{buffer.data() + i * block_size, block_size}, offset(), i),
+              "io_uring read");
+      }
+
+      check(ring.submit_and_wait(batch), "io_uring_enter");
+      std::size_t reaped{0u};
+      while (reaped < batch) {
+        reaped += ring.reap(span<lnx::io_uring_completion>{completions + reaped, batch - reaped});
+      }
+    };
+
+    const char *const variant{batch == 1u ? "io_uring, batch 1"
+                              : batch == 8u ? "io_uring, batch 8"
+                                            : "io_uring, batch 32"};
+    report("io_uring", variant, nanoseconds_per_operation(batch, round));
+  }
+}
+
+}  // namespace pposix::bench
@@ -0,0 +1,82 @@
+// Usage: pposix_benchmarks [benchmark...]
+//
+// Runs the named benchmarks, or all of them.
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iterator>
+
+#include "bench.hpp"
+
+namespace {
+
+struct benchmark {
+  const char *name;
+  void (*run)();
+};
+
+constexpr benchmark benchmarks[]{
+    {"io_uring", pposix::bench::io_uring_reads},
+    {"epoll", pposix::bench::epoll_updates},
+    {"epoll_jitter", pposix::bench::epoll_wakeup_jitter},
+    {"reactor", pposix::bench::reactor_dispatch},
+    {"reactor_group", pposix::bench::reactor_group_accepts},
+    {"timer_wheel", pposix::bench::timer_churn},
+    {"ping_pong", pposix::bench::ping_pong_latency},
+#if PPOSIX_COROUTINES_ENABLED
+    {"coroutine", pposix::bench::coroutine_wakeups},
+#endif
+    {"gather", pposix::bench::gather_sends},
+    {"datagram", pposix::bench::datagram_batches},
+    {"zerocopy", pposix::bench::zerocopy_sends},
+    {"tcp_cork", pposix::bench::request_latency},
+    {"reuseport", pposix::bench::reuseport_spread},
+    {"accept", pposix::bench::accept_storm},
+    {"socket_options", pposix::bench::profile_apply},
+    {"tcp_info", pposix::bench::tcp_info_sampling},
+    {"segmentation", pposix::bench::udp_segmentation},
+    {"sendfile", pposix::bench::file_to_socket},
+    {"fd_channel", pposix::bench::fd_handoff},
+    {"task_queue", pposix::bench::task_posting},
+    {"packet_ring", pposix::bench::packet_capture},
+    {"mmap", pposix::bench::mapped_scan},
+};
+
+bool selected(const benchmark &b, const int argc, char **argv) {
+  if (argc == 1) {
+    return true;
+  }
+
+  for (int i{1}; i < argc; ++i) {
+    if (std::strcmp(argv[i], b.name) == 0) {
+      return true;
+    }
+  }
+
+  return false;
+}
+
+}  // namespace
+
+int main(int argc, char **argv) {
+  for (int i{1}; i < argc; ++i) {
+    const auto known{std::find_if(std::begin(benchmarks), std::end(benchmarks),
+                                  [&](const benchmark &b) {
+                                    return std::strcmp(argv[i], b.name) == 0;
+                                  })};
+    if (known == std::end(benchmarks)) {
+      std::fprintf(stderr, "no such benchmark: %s\n", argv[i]);
+      return EXIT_FAILURE;
+    }
+  }
+
+  for (const benchmark &b : benchmarks) {
+    if (selected(b, argc, argv)) {
+      b.run();
+    }
+  }
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,63 @@
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <cstddef>
+#include <optional>
+
+#include "bench.hpp"
+#include "pposix/errno.hpp"
+#include "pposix/mman.hpp"
+
+namespace pposix::bench {
+
+namespace {
+
+constexpr std::size_t page_size{4096u};
+constexpr std::size_t file_size{32u * 1024u * 1024u};
+
+// Storing the sum of the bytes read keeps the reads from being optimised away.
+volatile unsigned scan_sum{0u};
+
+}  // namespace
+
+// A sequential scan of a 32 MiB file through a shared mapping, touching one byte per page, with
+// the file evicted from the page cache (posix_fadvise DONTNEED) before every scan: without advice
+// against mmap_advice::sequential and populate_read. The time is per page, including mapping,
+// advising and unmapping.
+void mapped_scan() {
+  const file f{temporary_file(file_size)};
+  const raw_fd_t fd{static_cast<raw_fd_t>(f.fd())};
+  if (::fdatasync(fd) != 0) {
+    check(current_errno_code(), "fdatasync");
+  }
+
+  const auto scan = [&](const std::optional<mmap_advice> advice) {
+    return [&, advice]() {
+      if (const int error{::posix_fadvise(fd, 0, 0, POSIX_FADV_DONTNEED)}) {
+        check(make_errno_code(std::errc{error}), "posix_fadvise");
+      }
+
+      auto map{check(mmap::map(nullptr, file_size, mmap_read, mmap_shared, f.fd(), 0), "mmap")};
+      if (advice) {
+        check(map.advise(*advice), "madvise");
+      }
+
+      const byte_cspan bytes{map.bytes()};
+      unsigned sum{0u};
+      for (std::size_t offset{0u}; offset < bytes.length(); offset += page_size) {
+        sum += static_cast<unsigned>(bytes.data()[offset]);
+      }
+
+      scan_sum = sum;
+      check(map.unmap(), "munmap");
+    };
+  };
+
+  constexpr std::size_t pages{file_size / page_size};
+  report("mmap", "no advice", nanoseconds_per_operation(pages, scan(std::nullopt)));
+  report("mmap", "sequential", nanoseconds_per_operation(pages, scan(mmap_advice::sequential)));
+  report("mmap", "populate_read",
+         nanoseconds_per_operation(pages, scan(mmap_advice::populate_read)));
+}
+
+}  // namespace pposix::bench
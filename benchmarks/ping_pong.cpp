@@ -0,0 +1,114 @@
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <thread>
+#include <vector>
+
+#include "bench.hpp"
+#include "pposix/address.hpp"
+#include "pposix/errno.hpp"
+#include "pposix/lnx/reactor.hpp"
+#include "pposix/socket.hpp"
+
+namespace pposix::bench {
+
+namespace {
+
+constexpr std::size_t warm_up_count{1000u};
+constexpr std::size_t ping_count{20000u};
+
+// Reads every pending datagram from s; echoes them back if asked to, otherwise counts them.
+class datagram_handler final : public lnx::reactor_handler {
+ public:
+  datagram_handler(socket &s, const bool echo) noexcept : socket_{&s}, echo_{echo} {}
+
+  void on_read() noexcept override {
+    std::byte payload[64];
+    byte_span buffers[]{payload};
+    while (const auto received{socket_->recvmsg(buffers, message_flag::dontwait)}) {
+      if (echo_) {
+        const byte_cspan reply[]{byte_cspan{payload, received->bytes()}};
+        (void)socket_->sendmsg(reply, message_flag::none);
+      }
+
+      ++received_;
+    }
+  }
+
+  std::size_t received() const noexcept { return received_; }
+
+ private:
+  socket *socket_;
+  bool echo_;
+  std::size_t received_{0u};
+};
+
+socket bound_udp_socket() {
+  socket s{check(socket::unsafe_make(socket_domain::inet, socket_type::dgram,
+                                     socket_flag::closexec | socket_flag::nonblock,
+                                     socket_protocol::udp),
+                 "socket")};
+  check(s.bind(inet_address::loopback(0u)), "bind");
+  return s;
+}
+
+}  // namespace
+
+// Round trips of a 64 byte UDP datagram over loopback between two threads that each drive a
+// reactor, one echoing what it receives: both reactors blocking in epoll_wait against both
+// spinning for up to 50 us under a reactor_spin_policy before they block. Each sample is one
+// round trip, measured by the sending thread.
+void ping_pong_latency() {
+  const auto run = [](const char *variant, const lnx::reactor_spin_policy policy) {
+    socket ping{bound_udp_socket()};
+    socket pong{bound_udp_socket()};
+    check(ping.connect(check(pong.local_address(), "getsockname")), "connect");
+    check(pong.connect(check(ping.local_address(), "getsockname")), "connect");
+
+    auto pinger{check(lnx::reactor::create(4u), "reactor")};
+    auto echoer{check(lnx::reactor::create(4u), "reactor")};
+    pinger.set_spin_policy(policy);
+    echoer.set_spin_policy(policy);
+
+    datagram_handler replies{ping, false};
+    datagram_handler echo{pong, true};
+    check(pinger.add(raw_fd{static_cast<raw_fd_t>(ping.fd())}, lnx::epoll_read_available,
+                     replies),
+          "epoll_ctl");
+    check(echoer.add(raw_fd{static_cast<raw_fd_t>(pong.fd())}, lnx::epoll_read_available, echo),
+          "epoll_ctl");
+
+    std::atomic<bool> stopping{false};
+    std::thread echo_thread{[&]() {
+      while (not stopping.load(std::memory_order_acquire)) {
+        check(echoer.run_once(milliseconds{10}), "run_once");
+      }
+    }};
+
+    std::byte payload[64]{};
+    const byte_cspan request[]{payload};
+    std::vector<nanoseconds> samples{};
+    samples.reserve(ping_count);
+    for (std::size_t i{0u}; i < warm_up_count + ping_count; ++i) {
+      const auto start{std::chrono::steady_clock::now()};
+      check(ping.sendmsg(request, message_flag::none), "sendmsg");
+      while (replies.received() <= i) {
+        check(pinger.run_once(milliseconds{1000}), "run_once");
+      }
+
+      if (i >= warm_up_count) {
+        samples.push_back(std::chrono::duration_cast<nanoseconds>(
+            std::chrono::steady_clock::now() - start));
+      }
+    }
+
+    stopping.store(true, std::memory_order_release);
+    echo_thread.join();
+    report_percentiles("ping_pong", variant, samples);
+  };
+
+  run("block", lnx::reactor_spin_policy{});
+  run("spin 50 us", lnx::reactor_spin_policy{std::chrono::microseconds{50}});
+}
+
+}  // namespace pposix::bench
@@ -0,0 +1,90 @@
+#include <sys/epoll.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <vector>
+
+#include "bench.hpp"
+#include "pposix/errno.hpp"
+#include "pposix/file_descriptor.hpp"
+#include "pposix/lnx/eventfd.hpp"
+#include "pposix/lnx/reactor.hpp"
+
+namespace pposix::bench {
+
+namespace {
+
+constexpr std::size_t fd_count{64u};
+
+class counting_handler final : public lnx::reactor_handler {
+ public:
+  void on_read() noexcept override { ++count_; }
+
+  uint64_t count() const noexcept { return count_; }
+
+ private:
+  uint64_t count_{0u};
+};
+
+}  // namespace
+
+// Dispatching readiness events for 64 eventfds that stay readable, so every wait returns 64
+// level-triggered events: a hand-written loop over epoll_wait that uses the event data as an index
+// against reactor::run_once calling a handler per event. The time is per event dispatched.
+void reactor_dispatch() {
+  std::vector<lnx::eventfd> events{};
+  for (std::size_t i{0u}; i < fd_count; ++i) {
+    events.push_back(
+        check(lnx::eventfd::create(0u, lnx::eventfd_cloexec | lnx::eventfd_nonblock), "eventfd"));
+    check(events.back().write(1u), "write (eventfd)");
+  }
+
+  {
+    const int epoll_fd{::epoll_create1(EPOLL_CLOEXEC)};
+    if (epoll_fd < 0) {
+      check(current_errno_code(), "epoll_create1");
+    }
+
+    const file_descriptor ep{raw_fd{epoll_fd}};
+    for (std::size_t i{0u}; i < fd_count; ++i) {
+      ::epoll_event event{};
+      event.events = EPOLLIN;
+      event.data.u64 = i;
+      if (::epoll_ctl(epoll_fd, EPOLL_CTL_ADD, static_cast<raw_fd_t>(events[i].fd()), &event) !=
+          0) {
+        check(current_errno_code(), "epoll_ctl");
+      }
+    }
+
+    std::vector<uint64_t> counts(fd_count);
+    ::epoll_event ready[fd_count];
+    report("reactor", "epoll_wait loop", nanoseconds_per_operation(fd_count, [&]() {
+             const int n{::epoll_wait(epoll_fd, ready, static_cast<int>(fd_count), 0)};
+             if (n != static_cast<int>(fd_count)) {
+               check(n < 0 ? current_errno_code() : make_errno_code(std::errc::io_error),
+                     "epoll_wait");
+             }
+
+             for (int i{0}; i < n; ++i) {
+               if ((ready[i].events & EPOLLIN) != 0u) {
+                 ++counts[ready[i].data.u64];
+               }
+             }
+           }));
+  }
+
+  auto r{check(lnx::reactor::create(fd_count), "reactor")};
+  std::deque<counting_handler> handlers(fd_count);
+  for (std::size_t i{0u}; i < fd_count; ++i) {
+    check(r.add(events[i].fd(), lnx::epoll_read_available, handlers[i]), "epoll_ctl");
+  }
+
+  report("reactor", "reactor::run_once", nanoseconds_per_operation(fd_count, [&]() {
+           if (check(r.run_once(milliseconds{0}), "run_once") != static_cast<int>(fd_count)) {
+             check(make_errno_code(std::errc::io_error), "run_once");
+           }
+         }));
+}
+
+}  // namespace pposix::bench
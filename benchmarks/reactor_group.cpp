@@ -0,0 +1,94 @@
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <thread>
+#include <vector>
+
+#include "bench.hpp"
+#include "pposix/address.hpp"
+#include "pposix/errno.hpp"
+#include "pposix/lnx/reactor_group.hpp"
+#include "pposix/socket.hpp"
+
+namespace pposix::bench {
+
+namespace {
+
+constexpr std::size_t connections_per_round{64u};
+
+// Accepts from whichever shard the kernel woke and closes the connection straight away.
+class accepting_handler final : public lnx::reactor_handler {
+ public:
+  explicit accepting_handler(socket &listener) noexcept : listener_{&listener} {}
+
+  void on_read() noexcept override {
+    const auto accepted{drain_accept(*listener_, socket_flag::closexec | socket_flag::nonblock,
+                                     [](socket) noexcept {})};
+    if (accepted) {
+      accepted_.fetch_add(*accepted, std::memory_order_release);
+    }
+  }
+
+  std::size_t accepted() const noexcept { return accepted_.load(std::memory_order_acquire); }
+
+ private:
+  socket *listener_;
+  std::atomic<std::size_t> accepted_{0u};
+};
+
+}  // namespace
+
+// A connect storm against one listening socket shared by every shard of a reactor_group with
+// epoll_exclusive: per round 64 clients connect over loopback and the round ends once the shards
+// have accepted all of them. Clients close with a zero linger so no TIME_WAIT state piles up. The
+// time is per connection accepted, for 1, 2 and 4 shards pinned to the CPUs in turn.
+void reactor_group_accepts() {
+  socket listener{check(socket::unsafe_make(socket_domain::inet, socket_type::stream,
+                                            socket_flag::closexec | socket_flag::nonblock,
+                                            socket_protocol::tcp),
+                        "socket")};
+  check(listener.bind(inet_address::loopback(0u)), "bind");
+  check(listener.listen(1024), "listen");
+  const auto address{check(listener.local_address(), "getsockname")};
+  const raw_fd listener_fd{static_cast<raw_fd_t>(listener.fd())};
+
+  constexpr std::size_t shard_counts[]{1u, 2u, 4u};
+  constexpr const char *variants[]{"1 shard", "2 shards", "4 shards"};
+
+  for (std::size_t v{0u}; v < std::size(shard_counts); ++v) {
+    auto group{check(lnx::reactor_group::create(shard_counts[v], 64u), "reactor_group")};
+    accepting_handler handler{listener};
+    check(group.add_shared(listener_fd, lnx::epoll_read_available, handler), "epoll_ctl");
+    check(group.start(lnx::reactor_affinity::pin_to_cpu), "start");
+
+    std::vector<socket> clients(connections_per_round);
+    std::size_t expected{0u};
+    report("reactor_group", variants[v],
+           nanoseconds_per_operation(connections_per_round, [&]() {
+             for (socket &client : clients) {
+               client = check(socket::unsafe_make(socket_domain::inet, socket_type::stream,
+                                                  socket_flag::closexec, socket_protocol::tcp),
+                              "socket");
+               check(client.setsockopt(socket_linger{true, seconds{0}}), "SO_LINGER");
+               check(client.connect(address), "connect");
+             }
+
+             expected += connections_per_round;
+             while (handler.accepted() < expected) {
+               std::this_thread::yield();
+             }
+
+             for (socket &client : clients) {
+               client = socket{};
+             }
+           }));
+
+    group.stop();
+    for (std::size_t i{0u}; i < group.size(); ++i) {
+      check(group.shard(i).remove(listener_fd), "epoll_ctl");
+    }
+  }
+}
+
+}  // namespace pposix::bench
@@ -0,0 +1,133 @@
+#include <pthread.h>
+#include <sched.h>
+
+#include <cstddef>
+#include <cstdio>
+#include <system_error>
+#include <vector>
+
+#include "bench.hpp"
+#include "pposix/address.hpp"
+#include "pposix/errno.hpp"
+#include "pposix/lnx/reuseport_group.hpp"
+#include "pposix/socket.hpp"
+
+namespace pposix::bench {
+
+namespace {
+
+constexpr std::size_t listener_count{4u};
+constexpr std::size_t connections_per_round{64u};
+
+socket tcp_socket(const socket_flag flags) {
+  return check(socket::unsafe_make(socket_domain::inet, socket_type::stream, flags,
+                                   socket_protocol::tcp),
+               "socket");
+}
+
+void set_affinity(const ::cpu_set_t &cpus) {
+  if (const int error{::pthread_setaffinity_np(::pthread_self(), sizeof(cpus), &cpus)}) {
+    check(make_errno_code(std::errc{error}), "pthread_setaffinity_np");
+  }
+}
+
+// Connect 64 clients per round from the CPUs of the calling thread in turn, accept them from
+// whichever listener the kernel picked and print the time per connection and the share each
+// listener got.
+void measure(const char *variant, std::vector<socket> &listeners) {
+  ::cpu_set_t allowed;
+  if (const int error{::pthread_getaffinity_np(::pthread_self(), sizeof(allowed), &allowed)}) {
+    check(make_errno_code(std::errc{error}), "pthread_getaffinity_np");
+  }
+
+  std::vector<unsigned> cpus{};
+  for (unsigned cpu{0u}; cpu < CPU_SETSIZE; ++cpu) {
+    if (CPU_ISSET(cpu, &allowed)) {
+      cpus.push_back(cpu);
+    }
+  }
+
+  const auto address{check(listeners.front().local_address(), "getsockname")};
+  std::vector<socket> clients(connections_per_round);
+  std::vector<std::size_t> accepted(listeners.size());
+  std::size_t round{0u};
+
+  report("reuseport", variant, nanoseconds_per_operation(connections_per_round, [&]() {
+           ::cpu_set_t cpu;
+           CPU_ZERO(&cpu);
+           CPU_SET(cpus[round++ % cpus.size()], &cpu);
+           set_affinity(cpu);
+
+           for (socket &client : clients) {
+             client = tcp_socket(socket_flag::closexec);
+             check(client.setsockopt(socket_linger{true, seconds{0}}), "SO_LINGER");
+             check(client.connect(address), "connect");
+           }
+
+           std::size_t total{0u};
+           while (total < connections_per_round) {
+             for (std::size_t i{0u}; i < listeners.size(); ++i) {
+               const std::size_t n{check(
+                   drain_accept(listeners[i], socket_flag::closexec, [](socket) noexcept {}),
+                   "accept")};
+               accepted[i] += n;
+               total += n;
+             }
+           }
+
+           for (socket &client : clients) {
+             client = socket{};
+           }
+         }));
+
+  set_affinity(allowed);
+
+  std::size_t total{0u};
+  for (const std::size_t n : accepted) {
+    total += n;
+  }
+
+  std::printf("%-16s %-32s", "reuseport", "  share per listener");
+  for (const std::size_t n : accepted) {
+    std::printf(" %5.1f%%", 100.0 * static_cast<double>(n) / static_cast<double>(total));
+  }
+
+  std::printf(" (%zu CPUs)\n", cpus.size());
+}
+
+}  // namespace
+
+// A loopback connect storm against four listeners sharing a port: plain SO_REUSEPORT sockets,
+// which the kernel picks between by hashing the flow, against a reuseport_group, whose BPF program
+// picks the listener of the CPU that received the connection. The connecting thread moves to the
+// next CPU every round of 64 connections. The time is per connection accepted, followed by the
+// share of connections each listener accepted.
+void reuseport_spread() {
+  {
+    std::vector<socket> listeners{};
+    for (std::size_t i{0u}; i < listener_count; ++i) {
+      listeners.push_back(tcp_socket(socket_flag::closexec | socket_flag::nonblock));
+      check(listeners.back().setsockopt(socket_reuseport::on), "SO_REUSEPORT");
+      check(i == 0u ? listeners.back().bind(inet_address::loopback(0u))
+                    : listeners.back().bind(check(listeners.front().local_address(),
+                                                  "getsockname")),
+            "bind");
+      check(listeners.back().listen(1024), "listen");
+    }
+
+    measure("4 SO_REUSEPORT listeners", listeners);
+  }
+
+  auto group{check(lnx::reuseport_group::create(socket_type::stream,
+                                                 socket_flag::closexec | socket_flag::nonblock,
+                                                 inet_address::loopback(0u), listener_count, 1024),
+                   "reuseport_group")};
+  std::vector<socket> listeners{};
+  for (std::size_t i{0u}; i < group.size(); ++i) {
+    listeners.push_back(std::move(group[i]));
+  }
+
+  measure("reuseport_group of 4", listeners);
+}
+
+}  // namespace pposix::bench
@@ -0,0 +1,84 @@
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <vector>
+
+#include "bench.hpp"
+#include "pposix/address.hpp"
+#include "pposix/lnx/udp.hpp"
+#include "pposix/socket.hpp"
+
+namespace pposix::bench {
+
+namespace {
+
+constexpr std::size_t segment_count{32u};
+constexpr uint16_t segment_size{1400u};
+
+socket udp_socket() {
+  return check(socket::unsafe_make(socket_domain::inet, socket_type::dgram, socket_flag::closexec,
+                                   socket_protocol::udp),
+               "socket");
+}
+
+}  // namespace
+
+// 1400 byte UDP datagrams over loopback, 32 per round: one sendmsg per datagram against one
+// send_segmented call for all of them, received one recvmsg per datagram or, with GRO enabled,
+// coalesced by recv_coalesced. The time is per datagram sent and received.
+void udp_segmentation() {
+  socket receiver{udp_socket()};
+  check(receiver.bind(inet_address::loopback(0u)), "bind");
+  socket gro_receiver{udp_socket()};
+  check(gro_receiver.setsockopt(socket_udp_gro::on), "UDP_GRO");
+  check(gro_receiver.bind(inet_address::loopback(0u)), "bind");
+
+  socket sender{udp_socket()};
+  check(sender.connect(check(receiver.local_address(), "getsockname")), "connect");
+  socket gro_sender{udp_socket()};
+  check(gro_sender.connect(check(gro_receiver.local_address(), "getsockname")), "connect");
+
+  std::vector<std::byte> payload(segment_count * segment_size);
+  const byte_cspan datagram_buffers[]{byte_cspan{payload.data(), segment_size}};
+  const byte_cspan payload_buffers[]{byte_cspan{payload.data(), payload.size()}};
+  std::vector<std::byte> received(64u * 1024u);
+  byte_span receive_buffers[]{byte_span{received.data(), received.size()}};
+
+  const auto receive_each = [&]() {
+    for (std::size_t i{0u}; i < segment_count; ++i) {
+      check(receiver.recvmsg(receive_buffers, message_flag::none), "recvmsg");
+    }
+  };
+
+  report("segmentation", "sendmsg + recvmsg", nanoseconds_per_operation(segment_count, [&]() {
+           for (std::size_t i{0u}; i < segment_count; ++i) {
+             check(sender.sendmsg(datagram_buffers, message_flag::none), "sendmsg");
+           }
+
+           receive_each();
+         }));
+
+  report("segmentation", "send_segmented + recvmsg",
+         nanoseconds_per_operation(segment_count, [&]() {
+           check(lnx::send_segmented(sender, payload_buffers, segment_size, message_flag::none),
+                 "sendmsg (UDP_SEGMENT)");
+           receive_each();
+         }));
+
+  report("segmentation", "send_segmented + recv_coalesced",
+         nanoseconds_per_operation(segment_count, [&]() {
+           check(
+               lnx::send_segmented(gro_sender, payload_buffers, segment_size, message_flag::none),
+               "sendmsg (UDP_SEGMENT)");
+
+           std::size_t count{0u};
+           while (count < segment_count) {
+             const auto segments{check(lnx::recv_coalesced(gro_receiver, receive_buffers[0],
+                                                            message_flag::none),
+                                       "recvmsg (UDP_GRO)")};
+             count += static_cast<std::size_t>(std::distance(segments.begin(), segments.end()));
+           }
+         }));
+}
+
+}  // namespace pposix::bench
@@ -0,0 +1,76 @@
+#include <unistd.h>
+
+#include <cstddef>
+#include <thread>
+#include <vector>
+
+#include "bench.hpp"
+#include "pposix/address.hpp"
+#include "pposix/errno.hpp"
+#include "pposix/lnx/splice.hpp"
+#include "pposix/socket.hpp"
+
+namespace pposix::bench {
+
+namespace {
+
+constexpr std::size_t chunk_size{64u * 1024u};
+constexpr std::size_t file_size{256u * chunk_size};
+
+socket tcp_socket() {
+  return check(socket::unsafe_make(socket_domain::inet, socket_type::stream, socket_flag::closexec,
+                                   socket_protocol::tcp),
+               "socket");
+}
+
+}  // namespace
+
+// A 16 MiB page cached file sent over a loopback TCP connection, read on the other end by another
+// thread: pread and write through a 64 KiB buffer against transfer, which uses sendfile. The time
+// is per 64 KiB sent.
+void file_to_socket() {
+  const file f{temporary_file(file_size)};
+
+  socket listener{tcp_socket()};
+  check(listener.bind(inet_address::loopback(0u)), "bind");
+  check(listener.listen(1), "listen");
+  socket sender{tcp_socket()};
+  check(sender.connect(check(listener.local_address(), "getsockname")), "connect");
+  socket receiver{check(listener.accept(socket_flag::closexec), "accept")};
+
+  std::thread drain{[&]() {
+    std::vector<std::byte> buffer(4u * chunk_size);
+    while (::read(static_cast<raw_fd_t>(receiver.fd()), buffer.data(), buffer.size()) > 0) {
+    }
+  }};
+
+  std::vector<std::byte> buffer(chunk_size);
+  report("sendfile", "pread + write", nanoseconds_per_operation(file_size / chunk_size, [&]() {
+           for (off_t offset{0}; offset < static_cast<off_t>(file_size);) {
+             const ssize_t n{::pread(static_cast<raw_fd_t>(f.fd()), buffer.data(), chunk_size,
+                                     offset)};
+             if (n < 0) {
+               check(current_errno_code(), "pread");
+             }
+
+             for (ssize_t sent{0}; sent < n;) {
+               const byte_cspan left[]{byte_cspan{buffer.data() + sent,
+                                                  static_cast<std::size_t>(n - sent)}};
+               sent += check(sender.sendmsg(left, message_flag::none), "sendmsg");
+             }
+
+             offset += n;
+           }
+         }));
+
+  report("sendfile", "transfer", nanoseconds_per_operation(file_size / chunk_size, [&]() {
+           off_t offset{0};
+           check(lnx::transfer(sender, f, offset, file_size), "sendfile");
+         }));
+
+  // Closing the connection ends the drain.
+  sender = socket{};
+  drain.join();
+}
+
+}  // namespace pposix::bench
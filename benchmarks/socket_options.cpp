@@ -0,0 +1,51 @@
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+
+#include "bench.hpp"
+#include "pposix/errno.hpp"
+#include "pposix/socket.hpp"
+
+namespace pposix::bench {
+
+namespace {
+
+void raw_setsockopt(const int fd, const int level, const int name, const void *value,
+                    const socklen_t length) {
+  if (::setsockopt(fd, level, name, value, length) != 0) {
+    check(current_errno_code(), "setsockopt");
+  }
+}
+
+}  // namespace
+
+// Applying a profile of six options to an accepted TCP socket, as a server would to every new
+// connection: 256 KiB send and receive buffers, TCP_NODELAY, no linger and 5 s send and receive
+// timeouts. One raw setsockopt per option with hand-built values against socket::apply. The time
+// is per profile applied.
+void profile_apply() {
+  auto [client, server] = tcp_pair();
+  const int fd{static_cast<raw_fd_t>(server.fd())};
+
+  report("socket_options", "setsockopt x6", nanoseconds_per_operation(1u, [&]() {
+           const int buffer_size{256 * 1024};
+           const int on{1};
+           const ::linger no_linger{0, 0};
+           const ::timeval timeout{5, 0};
+           raw_setsockopt(fd, SOL_SOCKET, SO_SNDBUF, &buffer_size, sizeof(buffer_size));
+           raw_setsockopt(fd, SOL_SOCKET, SO_RCVBUF, &buffer_size, sizeof(buffer_size));
+           raw_setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &on, sizeof(on));
+           raw_setsockopt(fd, SOL_SOCKET, SO_LINGER, &no_linger, sizeof(no_linger));
+           raw_setsockopt(fd, SOL_SOCKET, SO_SNDTIMEO, &timeout, sizeof(timeout));
+           raw_setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+         }));
+
+  report("socket_options", "socket::apply, 6 options", nanoseconds_per_operation(1u, [&]() {
+           check(server.apply(socket_sndbuf{256 * 1024}, socket_rcvbuf{256 * 1024},
+                              socket_tcp_nodelay::on, socket_linger{},
+                              socket_sndtimeo{seconds{5}}, socket_rcvtimeo{seconds{5}}),
+                 "setsockopt");
+         }));
+}
+
+}  // namespace pposix::bench
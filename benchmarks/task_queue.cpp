@@ -0,0 +1,129 @@
+#include <atomic>
+#include <cstddef>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "bench.hpp"
+#include "pposix/lnx/epoll.hpp"
+#include "pposix/lnx/eventfd.hpp"
+#include "pposix/lnx/task_queue.hpp"
+
+namespace pposix::bench {
+
+namespace {
+
+constexpr std::size_t tasks_per_round{256u};
+
+class counting_task final : public lnx::reactor_task {
+ public:
+  explicit counting_task(std::atomic<std::size_t> &done) noexcept : done_{done} {}
+
+  void run() noexcept override { done_.fetch_add(1u, std::memory_order_release); }
+
+ private:
+  std::atomic<std::size_t> &done_;
+};
+
+// What a caller would otherwise write: a mutex protected vector and an eventfd write per post.
+class locked_queue {
+ public:
+  locked_queue()
+      : event_{check(lnx::eventfd::create(0u, lnx::eventfd_cloexec | lnx::eventfd_nonblock),
+                     "eventfd")} {}
+
+  raw_fd fd() const noexcept { return event_.fd(); }
+
+  std::error_code post(lnx::reactor_task &task) {
+    {
+      const std::lock_guard<std::mutex> lock{mutex_};
+      tasks_.push_back(&task);
+    }
+
+    return event_.write(1u);
+  }
+
+  std::error_code wake() noexcept { return event_.write(1u); }
+
+  result<std::size_t> run_pending() {
+    static_cast<void>(event_.read());
+
+    {
+      const std::lock_guard<std::mutex> lock{mutex_};
+      std::swap(tasks_, running_);
+    }
+
+    for (lnx::reactor_task *const task : running_) {
+      task->run();
+    }
+
+    const std::size_t count{running_.size()};
+    running_.clear();
+    return count;
+  }
+
+ private:
+  lnx::eventfd event_;
+  std::mutex mutex_{};
+  std::vector<lnx::reactor_task *> tasks_{};
+  std::vector<lnx::reactor_task *> running_{};
+};
+
+// Post tasks_per_round tasks from this thread to a consumer thread waiting in epoll, and wait
+// until it has run them all.
+template <class Queue>
+double post_and_run(Queue &queue) {
+  std::atomic<std::size_t> done{0u};
+  std::atomic<bool> stop{false};
+  std::deque<counting_task> tasks{};
+  for (std::size_t i{0u}; i < tasks_per_round; ++i) {
+    tasks.emplace_back(done);
+  }
+
+  auto ep{check(lnx::epoll::create(lnx::epoll_cloexec), "epoll_create1")};
+  check(ep.ctl(lnx::epoll_add{
+            queue.fd(), lnx::capi::epoll_event{lnx::capi::epoll_event_flag::read_available}}),
+        "epoll_ctl");
+
+  std::thread consumer{[&]() {
+    lnx::epoll_event events[1];
+    while (not stop.load(std::memory_order_acquire)) {
+      check(ep.wait(events, milliseconds{100}), "epoll_wait");
+      check(queue.run_pending(), "run_pending");
+    }
+  }};
+
+  std::size_t posted{0u};
+  const double nanoseconds{nanoseconds_per_operation(tasks_per_round, [&]() {
+    for (counting_task &task : tasks) {
+      check(queue.post(task), "post");
+    }
+
+    posted += tasks_per_round;
+    while (done.load(std::memory_order_acquire) != posted) {
+      std::this_thread::yield();
+    }
+  })};
+
+  stop.store(true, std::memory_order_release);
+  check(queue.wake(), "wake");
+  consumer.join();
+  return nanoseconds;
+}
+
+}  // namespace
+
+// 256 tasks posted per round from one thread to another that waits in epoll and runs them: a
+// mutex protected queue with an eventfd write per post against task_queue. The time is per task,
+// from the first post of a round until the last task has run.
+void task_posting() {
+  locked_queue locked{};
+  report("task_queue", "mutex + eventfd per post", post_and_run(locked));
+
+  lnx::task_queue queue{check(lnx::task_queue::create(), "eventfd")};
+  report("task_queue", "task_queue", post_and_run(queue));
+}
+
+}  // namespace pposix::bench
@@ -0,0 +1,86 @@
+#include <chrono>
+#include <cstddef>
+#include <thread>
+#include <vector>
+
+#include "bench.hpp"
+#include "pposix/lnx/tcp.hpp"
+#include "pposix/socket.hpp"
+
+namespace pposix::bench {
+
+namespace {
+
+constexpr std::size_t warm_up_count{20u};
+constexpr std::size_t request_count{200u};
+
+constexpr std::size_t header_size{16u};
+constexpr std::size_t request_body_size{100u};
+constexpr std::size_t response_body_size{1000u};
+
+enum class write_mode { nagle, nodelay, nodelay_cork };
+
+// Write a message as a header and a body in two writes, as a server that formats the header
+// before producing the body would.
+void write_message(socket &s, const write_mode mode, const std::size_t body_size) {
+  static const std::byte header[header_size]{};
+  static const std::byte body[response_body_size]{};
+  const byte_cspan header_buffers[]{header};
+  const byte_cspan body_buffers[]{byte_cspan{body, body_size}};
+
+  if (mode == write_mode::nodelay_cork) {
+    auto batch{check(lnx::tcp_cork_batch::create(s), "TCP_CORK")};
+    check(s.sendmsg(header_buffers, message_flag::none), "sendmsg");
+    check(s.sendmsg(body_buffers, message_flag::none), "sendmsg");
+    check(batch.uncork(), "TCP_CORK");
+    return;
+  }
+
+  check(s.sendmsg(header_buffers, message_flag::none), "sendmsg");
+  check(s.sendmsg(body_buffers, message_flag::none), "sendmsg");
+}
+
+}  // namespace
+
+// Request/response round trips over a loopback TCP connection where both sides write their
+// message as a 16 byte header followed by the body, 100 bytes for the request and 1000 for the
+// response: with Nagle's algorithm, whose second write waits for the peer's delayed ack, with
+// TCP_NODELAY, which sends each write as its own segment, and with TCP_NODELAY plus a
+// tcp_cork_batch around the two writes. Each sample is one round trip, measured by the client.
+void request_latency() {
+  const auto run = [](const char *variant, const write_mode mode) {
+    auto [client, server] = tcp_pair();
+    if (mode != write_mode::nagle) {
+      check(client.setsockopt(socket_tcp_nodelay::on), "TCP_NODELAY");
+      check(server.setsockopt(socket_tcp_nodelay::on), "TCP_NODELAY");
+    }
+
+    std::thread responder{[&, &server = server]() {
+      for (std::size_t i{0u}; i < warm_up_count + request_count; ++i) {
+        receive_bytes(server, header_size + request_body_size);
+        write_message(server, mode, response_body_size);
+      }
+    }};
+
+    std::vector<nanoseconds> samples{};
+    samples.reserve(request_count);
+    for (std::size_t i{0u}; i < warm_up_count + request_count; ++i) {
+      const auto start{std::chrono::steady_clock::now()};
+      write_message(client, mode, request_body_size);
+      receive_bytes(client, header_size + response_body_size);
+      if (i >= warm_up_count) {
+        samples.push_back(std::chrono::duration_cast<nanoseconds>(
+            std::chrono::steady_clock::now() - start));
+      }
+    }
+
+    responder.join();
+    report_percentiles("tcp_cork", variant, samples);
+  };
+
+  run("Nagle", write_mode::nagle);
+  run("TCP_NODELAY", write_mode::nodelay);
+  run("TCP_NODELAY + tcp_cork_batch", write_mode::nodelay_cork);
+}
+
+}  // namespace pposix::bench
@@ -0,0 +1,65 @@
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+#include "bench.hpp"
+#include "pposix/errno.hpp"
+#include "pposix/socket.hpp"
+
+namespace pposix::bench {
+
+namespace {
+
+constexpr std::size_t connection_count{64u};
+
+}  // namespace
+
+// Sampling the statistics of 64 established loopback TCP connections: one getsockopt(TCP_INFO)
+// per socket into glibc's struct tcp_info, sample_tcp_info over all of them into preallocated
+// snapshots, and socket::tcp_info plus the three queue depth ioctls per socket. The time is per
+// socket sampled.
+void tcp_info_sampling() {
+  std::vector<std::pair<socket, socket>> connections{};
+  std::vector<socket_fd> fds{};
+  for (std::size_t i{0u}; i < connection_count; ++i) {
+    connections.push_back(tcp_pair());
+    fds.push_back(connections.back().first.fd());
+  }
+
+  report("tcp_info", "getsockopt(TCP_INFO)", nanoseconds_per_operation(connection_count, [&]() {
+           for (const socket_fd fd : fds) {
+             ::tcp_info info{};
+             socklen_t length{sizeof(info)};
+             if (::getsockopt(static_cast<int>(fd), IPPROTO_TCP, TCP_INFO, &info, &length) != 0) {
+               check(current_errno_code(), "getsockopt");
+             }
+           }
+         }));
+
+  std::vector<tcp_info_snapshot> snapshots(connection_count);
+  report("tcp_info", "sample_tcp_info", nanoseconds_per_operation(connection_count, [&]() {
+           const std::size_t sampled{
+               sample_tcp_info(cspan<socket_fd>{fds.data(), fds.size()},
+                               span<tcp_info_snapshot>{snapshots.data(), snapshots.size()})};
+           if (sampled != connection_count) {
+             check(make_errno_code(std::errc::io_error), "sample_tcp_info");
+           }
+         }));
+
+  report("tcp_info", "tcp_info + 3 queue ioctls",
+         nanoseconds_per_operation(connection_count, [&]() {
+           for (auto &connection : connections) {
+             socket &s{connection.first};
+             check(s.tcp_info(), "getsockopt");
+             check(s.input_queue(), "SIOCINQ");
+             check(s.output_queue(), "SIOCOUTQ");
+             check(s.unsent_queue(), "SIOCOUTQNSD");
+           }
+         }));
+}
+
+}  // namespace pposix::bench
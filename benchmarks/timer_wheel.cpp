@@ -0,0 +1,63 @@
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <vector>
+
+#include "bench.hpp"
+#include "pposix/lnx/timer_wheel.hpp"
+
+namespace pposix::bench {
+
+namespace {
+
+constexpr std::size_t timer_count{1000000u};
+
+class noop_timer final : public lnx::timer {
+ public:
+  void on_expire() noexcept override {}
+};
+
+// Spread the delays over a second so the timers land on both of the wheel's first two levels.
+nanoseconds delay_of(const std::size_t i) noexcept {
+  return std::chrono::microseconds{static_cast<int64_t>((i * 7919u) % 1000000u)};
+}
+
+}  // namespace
+
+// Inserting 1M timers with delays spread over a second, then cancelling all of them: an ordered
+// std::multimap of deadlines, erased through the iterators kept from inserting, against a
+// timer_wheel with a 1 ms tick. The time is per timer inserted and cancelled.
+void timer_churn() {
+  {
+    using clock = std::chrono::steady_clock;
+    std::multimap<clock::time_point, noop_timer *> deadlines{};
+    std::vector<decltype(deadlines)::iterator> handles(timer_count);
+    noop_timer t{};
+
+    report("timer_wheel", "std::multimap", nanoseconds_per_operation(timer_count, [&]() {
+             for (std::size_t i{0u}; i < timer_count; ++i) {
+               handles[i] = deadlines.emplace(clock::now() + delay_of(i), &t);
+             }
+
+             for (const auto handle : handles) {
+               deadlines.erase(handle);
+             }
+           }));
+  }
+
+  auto wheel{check(lnx::timer_wheel::create(std::chrono::milliseconds{1}), "timer_wheel")};
+  std::vector<noop_timer> timers(timer_count);
+
+  report("timer_wheel", "timer_wheel", nanoseconds_per_operation(timer_count, [&]() {
+           for (std::size_t i{0u}; i < timer_count; ++i) {
+             check(wheel.schedule(timers[i], delay_of(i)), "schedule");
+           }
+
+           for (noop_timer &t : timers) {
+             check(wheel.cancel(t), "cancel");
+           }
+         }));
+}
+
+}  // namespace pposix::bench
@@ -0,0 +1,134 @@
+#include <sys/resource.h>
+#include <sys/socket.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <thread>
+#include <vector>
+
+#include "bench.hpp"
+#include "pposix/errno.hpp"
+#include "pposix/lnx/zerocopy.hpp"
+#include "pposix/socket.hpp"
+
+namespace pposix::bench {
+
+namespace {
+
+constexpr std::size_t bytes_per_variant{512u * 1024u * 1024u};
+constexpr std::size_t send_sizes[]{64u * 1024u, 256u * 1024u, 1024u * 1024u};
+
+std::chrono::nanoseconds cpu_time(const int who) {
+  ::rusage usage{};
+  if (::getrusage(who, &usage) != 0) {
+    check(current_errno_code(), "getrusage");
+  }
+
+  const auto time_of = [](const ::timeval &t) {
+    return std::chrono::seconds{t.tv_sec} + std::chrono::microseconds{t.tv_usec};
+  };
+  return time_of(usage.ru_utime) + time_of(usage.ru_stime);
+}
+
+// Call send(sent), which returns the number of bytes it sent, until bytes_per_variant bytes have
+// been sent while another thread reads them, and print the CPU time the sending thread and the
+// whole process spent per GB.
+template <class Send>
+void measure(const char *variant, socket &receiver, Send &&send) {
+  std::thread reader{[&]() { receive_bytes(receiver, bytes_per_variant); }};
+
+  const auto thread_start{cpu_time(RUSAGE_THREAD)};
+  const auto process_start{cpu_time(RUSAGE_SELF)};
+  const auto wall_start{std::chrono::steady_clock::now()};
+  for (std::size_t sent{0u}; sent < bytes_per_variant;) {
+    sent += send(sent);
+  }
+
+  reader.join();
+  const auto wall{std::chrono::steady_clock::now() - wall_start};
+  const auto thread_cpu{cpu_time(RUSAGE_THREAD) - thread_start};
+  const auto process_cpu{cpu_time(RUSAGE_SELF) - process_start};
+
+  const double gigabytes{static_cast<double>(bytes_per_variant) / 1e9};
+  const auto milliseconds_per_gigabyte = [&](const auto duration) {
+    return std::chrono::duration<double, std::milli>{duration}.count() / gigabytes;
+  };
+  std::printf("%-16s %-32s sender %7.1f ms/GB  process %7.1f ms/GB  %5.2f GB/s\n", "zerocopy",
+              variant, milliseconds_per_gigabyte(thread_cpu),
+              milliseconds_per_gigabyte(process_cpu),
+              gigabytes / std::chrono::duration<double>{wall}.count());
+}
+
+}  // namespace
+
+// 512 MiB sent over a loopback TCP connection in sends of 64 KiB, 256 KiB and 1 MiB while another
+// thread reads them: plain sendmsg against zerocopy_sender, which reaps completions after every
+// send and waits for the last ones at the end. Reports the CPU time per GB of the sending thread
+// and of the whole process (sender and reader), and the throughput. Loopback delivers the pages
+// to a local socket, so the kernel copies them anyway and reports every completion as copied().
+void zerocopy_sends() {
+  for (const std::size_t send_size : send_sizes) {
+    const std::vector<std::byte> data(send_size);
+    char variant[64];
+
+    {
+      auto [sender, receiver] = tcp_pair();
+      std::snprintf(variant, sizeof(variant), "sendmsg, %zu KiB", send_size / 1024u);
+      measure(variant, receiver, [&, &sender = sender](const std::size_t sent) {
+        const std::size_t length{std::min(send_size, bytes_per_variant - sent)};
+        const byte_cspan buffers[]{byte_cspan{data.data(), length}};
+        return static_cast<std::size_t>(
+            check(sender.sendmsg(buffers, message_flag::none), "sendmsg"));
+      });
+    }
+
+    auto [sender, receiver] = tcp_pair();
+    auto zerocopy{check(lnx::zerocopy_sender::create(sender), "SO_ZEROCOPY")};
+    lnx::zerocopy_completion completions[64];
+    uint64_t copied{0u};
+    uint64_t completed{0u};
+    const auto reap = [&]() {
+      const std::size_t count{check(zerocopy.reap(completions), "recvmsg (MSG_ERRQUEUE)")};
+      for (std::size_t i{0u}; i < count; ++i) {
+        completed += completions[i].count();
+        copied += completions[i].copied() ? completions[i].count() : 0u;
+      }
+    };
+
+    std::snprintf(variant, sizeof(variant), "zerocopy_sender, %zu KiB", send_size / 1024u);
+    measure(variant, receiver, [&](const std::size_t sent) -> std::size_t {
+      const std::size_t length{std::min(send_size, bytes_per_variant - sent)};
+      const byte_cspan buffers[]{byte_cspan{data.data(), length}};
+      const auto res{zerocopy.send(buffers, message_flag::none)};
+      if (not res) {
+        // Too many notifications are outstanding: let the reader catch up.
+        if (res.error() != std::errc::no_buffer_space) {
+          check(res.error(), "sendmsg (MSG_ZEROCOPY)");
+        }
+
+        reap();
+        std::this_thread::yield();
+        return 0u;
+      }
+
+      reap();
+      if (sent + res->bytes == bytes_per_variant) {
+        while (zerocopy.pending() != 0u) {
+          std::this_thread::yield();
+          reap();
+        }
+      }
+
+      return res->bytes;
+    });
+
+    if (completed != 0u and copied == completed) {
+      std::printf("zerocopy         every completion reported copied()\n");
+    }
+  }
+}
+
+}  // namespace pposix::bench
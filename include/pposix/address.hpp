@@ -0,0 +1,192 @@
+#pragma once
+
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string_view>
+
+#include "pposix/result.hpp"
+
+namespace pposix {
+
+enum class socket_domain : int;
+
+namespace detail {
+
+constexpr uint16_t host_to_network(const uint16_t value) noexcept {
+#if __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+  return static_cast<uint16_t>((value >> 8u) | (value << 8u));
+#else
+  return value;
+#endif
+}
+
+constexpr uint32_t host_to_network(const uint32_t value) noexcept {
+#if __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+  return ((value & 0xffu) << 24u) | ((value & 0xff00u) << 8u) | ((value >> 8u) & 0xff00u) |
+         (value >> 24u);
+#else
+  return value;
+#endif
+}
+
+// Byte swapping is its own inverse.
+constexpr uint16_t network_to_host(const uint16_t value) noexcept {
+  return host_to_network(value);
+}
+
+constexpr uint32_t network_to_host(const uint32_t value) noexcept {
+  return host_to_network(value);
+}
+
+}  // namespace detail
+
+// Address types are trivially copyable wrappers around the sockaddr structures. Each one has
+// domain(), data() and length(), which is what socket::bind, socket::connect and friends take.
+
+class inet_address {
+ public:
+  constexpr inet_address() noexcept : inet_address{0u, 0u, 0u, 0u, 0u} {}
+
+  constexpr inet_address(uint8_t a, uint8_t b, uint8_t c, uint8_t d, uint16_t port) noexcept
+      : address_{} {
+    address_.sin_family = AF_INET;
+    address_.sin_port = detail::host_to_network(port);
+    address_.sin_addr.s_addr = detail::host_to_network(
+        (uint32_t{a} << 24u) | (uint32_t{b} << 16u) | (uint32_t{c} << 8u) | uint32_t{d});
+  }
+
+  constexpr explicit inet_address(const ::sockaddr_in &address) noexcept : address_{address} {}
+
+  static constexpr inet_address any(const uint16_t port) noexcept {
+    return {0u, 0u, 0u, 0u, port};
+  }
+
+  static constexpr inet_address loopback(const uint16_t port) noexcept {
+    return {127u, 0u, 0u, 1u, port};
+  }
+
+  constexpr socket_domain domain() const noexcept { return socket_domain{AF_INET}; }
+
+  constexpr uint16_t port() const noexcept { return detail::network_to_host(address_.sin_port); }
+
+  constexpr std::array<uint8_t, 4u> octets() const noexcept {
+    const uint32_t host{detail::network_to_host(address_.sin_addr.s_addr)};
+    return {static_cast<uint8_t>(host >> 24u), static_cast<uint8_t>(host >> 16u),
+            static_cast<uint8_t>(host >> 8u), static_cast<uint8_t>(host)};
+  }
+
+  const ::sockaddr *data() const noexcept {
+    return reinterpret_cast<const ::sockaddr *>(&address_);
+  }
+
+  constexpr socklen_t length() const noexcept { return sizeof(address_); }
+
+ private:
+  ::sockaddr_in address_;
+};
+
+class inet6_address {
+ public:
+  constexpr inet6_address() noexcept : inet6_address{std::array<uint8_t, 16u>{}, 0u} {}
+
+  constexpr inet6_address(const std::array<uint8_t, 16u> &bytes, uint16_t port) noexcept
+      : address_{} {
+    address_.sin6_family = AF_INET6;
+    address_.sin6_port = detail::host_to_network(port);
+    for (std::size_t i = 0u; i < bytes.size(); ++i) {
+      address_.sin6_addr.s6_addr[i] = bytes[i];
+    }
+  }
+
+  constexpr explicit inet6_address(const ::sockaddr_in6 &address) noexcept : address_{address} {}
+
+  static constexpr inet6_address any(const uint16_t port) noexcept {
+    return {std::array<uint8_t, 16u>{}, port};
+  }
+
+  static constexpr inet6_address loopback(const uint16_t port) noexcept {
+    std::array<uint8_t, 16u> bytes{};
+    bytes[15] = 1u;
+    return {bytes, port};
+  }
+
+  constexpr socket_domain domain() const noexcept { return socket_domain{AF_INET6}; }
+
+  constexpr uint16_t port() const noexcept { return detail::network_to_host(address_.sin6_port); }
+
+  constexpr std::array<uint8_t, 16u> bytes() const noexcept {
+    std::array<uint8_t, 16u> bytes{};
+    for (std::size_t i = 0u; i < bytes.size(); ++i) {
+      bytes[i] = address_.sin6_addr.s6_addr[i];
+    }
+
+    return bytes;
+  }
+
+  const ::sockaddr *data() const noexcept {
+    return reinterpret_cast<const ::sockaddr *>(&address_);
+  }
+
+  constexpr socklen_t length() const noexcept { return sizeof(address_); }
+
+ private:
+  ::sockaddr_in6 address_;
+};
+
+class unix_address {
+ public:
+  // Fails with filename_too_long if the path does not fit in sockaddr_un.
+  static result<unix_address> create(std::string_view path) noexcept;
+
+  constexpr socket_domain domain() const noexcept { return socket_domain{AF_UNIX}; }
+
+  std::string_view path() const noexcept;
+
+  const ::sockaddr *data() const noexcept {
+    return reinterpret_cast<const ::sockaddr *>(&address_);
+  }
+
+  constexpr socklen_t length() const noexcept { return length_; }
+
+ private:
+  unix_address() noexcept = default;
+
+  ::sockaddr_un address_{};
+  socklen_t length_{};
+};
+
+// An address of any domain, as filled in by accept or getsockname.
+class socket_address {
+ public:
+  constexpr socket_address() noexcept = default;
+
+  constexpr socket_domain domain() const noexcept { return socket_domain{storage_.ss_family}; }
+
+  std::optional<inet_address> inet() const noexcept;
+  std::optional<inet6_address> inet6() const noexcept;
+
+  const ::sockaddr *data() const noexcept {
+    return reinterpret_cast<const ::sockaddr *>(&storage_);
+  }
+
+  ::sockaddr *data() noexcept { return reinterpret_cast<::sockaddr *>(&storage_); }
+
+  constexpr socklen_t length() const noexcept { return length_; }
+
+  constexpr socklen_t capacity() const noexcept { return sizeof(storage_); }
+
+  // For the calls that report how much of the storage they filled in.
+  constexpr socklen_t *length_ptr() noexcept { return &length_; }
+
+ private:
+  ::sockaddr_storage storage_{};
+  socklen_t length_{sizeof(storage_)};
+};
+
+}  // namespace pposix
@@ -0,0 +1,126 @@
+#pragma once
+
+#include <sys/socket.h>
+
+#include <cstddef>
+#include <cstring>
+#include <iterator>
+#include <system_error>
+#include <type_traits>
+
+#include "pposix/byte_span.hpp"
+#include "pposix/result.hpp"
+
+namespace pposix {
+
+enum class socket_level : int;
+
+// Space needed in a control buffer for a control message carrying Length bytes of data. Declare
+// control buffers as `alignas(::cmsghdr) std::byte buffer[cmsg_space(...) + ...]`.
+constexpr std::size_t cmsg_space(const std::size_t length) noexcept { return CMSG_SPACE(length); }
+
+// One control message (ancillary data) in a control buffer.
+class cmsg {
+ public:
+  constexpr explicit cmsg(const ::cmsghdr *header) noexcept : header_{header} {}
+
+  socket_level level() const noexcept { return socket_level{header_->cmsg_level}; }
+
+  int type() const noexcept { return header_->cmsg_type; }
+
+  byte_cspan data() const noexcept;
+
+  // Copy the data out as a T. Control message data is not necessarily aligned for T, so it cannot
+  // be read in place.
+  template <class T>
+  T value() const noexcept {
+    static_assert(std::is_trivially_copyable_v<T>);
+
+    T val{};
+    const byte_cspan bytes{data()};
+    std::memcpy(&val, bytes.data(), bytes.length() < sizeof(T) ? bytes.length() : sizeof(T));
+    return val;
+  }
+
+ private:
+  const ::cmsghdr *header_;
+};
+
+// The control messages in a control buffer filled in by recvmsg.
+class cmsg_range {
+ public:
+  class iterator {
+   public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = cmsg;
+    using difference_type = std::ptrdiff_t;
+    using pointer = void;
+    using reference = cmsg;
+
+    iterator() noexcept = default;
+
+    cmsg operator*() const noexcept { return cmsg{header_}; }
+
+    iterator &operator++() noexcept;
+
+    iterator operator++(int) noexcept {
+      iterator previous{*this};
+      ++*this;
+      return previous;
+    }
+
+    bool operator==(const iterator &other) const noexcept { return header_ == other.header_; }
+    bool operator!=(const iterator &other) const noexcept { return header_ != other.header_; }
+
+   private:
+    friend class cmsg_range;
+
+    iterator(const ::msghdr &message, const ::cmsghdr *header) noexcept
+        : message_{message}, header_{header} {}
+
+    ::msghdr message_{};
+    const ::cmsghdr *header_{nullptr};
+  };
+
+  constexpr cmsg_range() noexcept = default;
+
+  constexpr explicit cmsg_range(const byte_cspan control) noexcept : control_{control} {}
+
+  iterator begin() const noexcept;
+  iterator end() const noexcept { return {}; }
+
+  bool empty() const noexcept { return begin() == end(); }
+
+ private:
+  byte_cspan control_{};
+};
+
+// Appends control messages to a caller provided buffer, which must be aligned for cmsghdr. Pass
+// data() as the control buffer of sendmsg.
+class cmsg_writer {
+ public:
+  constexpr explicit cmsg_writer(const byte_span buffer) noexcept : buffer_{buffer} {}
+
+  // Fails with no_buffer_space if the message does not fit in what is left of the buffer.
+  std::error_code add(socket_level level, int type, byte_cspan data) noexcept;
+
+  // Add a message with length bytes of zeroed data and return the data, for callers that build it
+  // in place rather than copy it from elsewhere. Fails as add does.
+  result<byte_span> append(socket_level level, int type, std::size_t length) noexcept;
+
+  template <class T>
+  std::error_code add(const socket_level level, const int type, const T &value) noexcept {
+    static_assert(std::is_trivially_copyable_v<T>);
+    return add(level, type, byte_cspan{reinterpret_cast<const std::byte *>(&value), sizeof(T)});
+  }
+
+  void clear() noexcept { used_ = 0u; }
+
+  byte_cspan data() const noexcept { return byte_cspan{buffer_.data(), used_}; }
+
+ private:
+  byte_span buffer_;
+  std::size_t used_{0u};
+};
+
+}  // namespace pposix
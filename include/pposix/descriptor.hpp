@@ -33,6 +33,10 @@ class [[nodiscard]] descriptor {
   constexpr explicit descriptor(Descriptor descriptor) : raw_descriptor_{descriptor} {}
 
   ~descriptor() {
+    if (empty()) {
+      return;
+    }
+
     if (const auto error = close()) {
       // TODO: Log this fatal error.
     }
@@ -47,6 +51,7 @@ class [[nodiscard]] descriptor {
 
   constexpr descriptor &operator=(descriptor &&other) noexcept {
     std::swap(raw_descriptor_, other.raw_descriptor_);
+    return *this;
   }
 
   [[nodiscard]] constexpr bool empty() const noexcept { return raw_descriptor_ == GetNull{}(); }
@@ -25,3 +25,8 @@
 #ifndef PPOSIX_REALTIME_EXTENSION_ENABLED
 #define PPOSIX_REALTIME_EXTENSION_ENABLED 0
 #endif
+
+// Language features
+#ifndef PPOSIX_COROUTINES_ENABLED
+#define PPOSIX_COROUTINES_ENABLED 0
+#endif
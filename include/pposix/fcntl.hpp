@@ -64,9 +64,10 @@ constexpr fcntl_cmd &operator|=(fcntl_cmd &lhs, fcntl_cmd rhs) noexcept {
   return lhs;
 }
 
-std::error_code fcntl(capi::fcntl_cmd cmd) noexcept;
-std::error_code fcntl(capi::fcntl_cmd cmd, int arg) noexcept;
-std::error_code fcntl(capi::fcntl_cmd cmd, void *arg) noexcept;
+// Returns the value of the command, e.g. the flags for getfl or the pipe size for setpipe_sz.
+result<int> fcntl(raw_fd fd, capi::fcntl_cmd cmd) noexcept;
+result<int> fcntl(raw_fd fd, capi::fcntl_cmd cmd, int arg) noexcept;
+result<int> fcntl(raw_fd fd, capi::fcntl_cmd cmd, void *arg) noexcept;
 
 enum class open_flag : unsigned {
   cloexec = O_CLOEXEC,
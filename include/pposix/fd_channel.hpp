@@ -0,0 +1,111 @@
+#pragma once
+
+#include <sys/socket.h>
+
+#include <cstddef>
+#include <utility>
+
+#include "pposix/byte_span.hpp"
+#include "pposix/extension.hpp"
+#include "pposix/file_descriptor.hpp"
+#include "pposix/result.hpp"
+#include "pposix/socket.hpp"
+#include "pposix/span.hpp"
+
+namespace pposix {
+
+namespace detail {
+
+constexpr int fd_value(const raw_fd fd) noexcept { return static_cast<raw_fd_t>(fd); }
+constexpr int fd_value(const socket_fd fd) noexcept { return static_cast<socket_fd_t>(fd); }
+constexpr int fd_value(const file_descriptor &fd) noexcept { return fd_value(*fd); }
+constexpr int fd_value(const unique_socket_fd &fd) noexcept { return fd_value(*fd); }
+inline int fd_value(const socket &s) noexcept { return fd_value(s.fd()); }
+
+}  // namespace detail
+
+// What fd_channel::receive received: the payload bytes and the number of descriptors stored.
+class received_fds {
+ public:
+  constexpr received_fds() noexcept = default;
+
+  constexpr received_fds(std::size_t bytes, std::size_t fd_count, message_flag flags) noexcept
+      : bytes_{bytes}, fd_count_{fd_count}, flags_{flags} {}
+
+  constexpr std::size_t bytes() const noexcept { return bytes_; }
+
+  constexpr std::size_t fd_count() const noexcept { return fd_count_; }
+
+  // More descriptors were sent than there was room for. The kernel closed the ones that did not
+  // fit.
+  constexpr bool fds_truncated() const noexcept {
+    return (flags_ & message_flag::ctrunc) != message_flag::none;
+  }
+
+  constexpr bool payload_truncated() const noexcept {
+    return (flags_ & message_flag::trunc) != message_flag::none;
+  }
+
+ private:
+  std::size_t bytes_{};
+  std::size_t fd_count_{};
+  message_flag flags_{message_flag::none};
+};
+
+// Hands descriptors to another process over a Unix domain socket. Each send is a single sendmsg
+// carrying a batch of descriptors as SCM_RIGHTS along with a payload describing them; the receiver
+// gets new descriptors for the same open files, owned by the file_descriptors it passes in.
+class fd_channel {
+ public:
+#if PPOSIX_LINUX_EXTENSION_ENABLED
+  // The most descriptors the kernel accepts in one message (SCM_MAX_FD).
+  static constexpr std::size_t max_fds{253u};
+#else
+  // POSIX sets no limit and other systems publish none; a conservative bound that also keeps the
+  // control buffer small. A batch the kernel still rejects fails with its error.
+  static constexpr std::size_t max_fds{64u};
+#endif
+
+  fd_channel() noexcept = default;
+
+  // s must be a Unix domain socket.
+  explicit fd_channel(socket s) noexcept;
+
+  // Both ends of a connected SOCK_SEQPACKET socket pair, which keeps each batch and its payload
+  // together as one message. Create it before forking and keep one end on each side.
+  static result<std::pair<fd_channel, fd_channel>> create_pair(socket_flag flags) noexcept;
+
+  socket &get() noexcept { return socket_; }
+
+  // Send the descriptors along with the payload, which must not be empty on a stream socket. The
+  // descriptors stay open in this process; close them once sent to complete a hand-off. Returns
+  // the number of payload bytes sent.
+  template <class Fd>
+  result<std::size_t> send(const cspan<Fd> fds, const byte_cspan payload,
+                           const message_flag flags) noexcept {
+    if (fds.length() > max_fds) {
+      return make_errno_code(std::errc::argument_list_too_long);
+    }
+
+    // The values are written straight into the control message, which is sized to the batch.
+    const auto fd_at = [](const void *batch, const std::size_t i) noexcept {
+      return detail::fd_value(static_cast<const Fd *>(batch)[i]);
+    };
+    return send_fds(fds.data(), fds.length(), fd_at, payload, flags);
+  }
+
+  // Receive a payload and up to fds.length() descriptors into fds, replacing (and closing) what
+  // they held. Pass message_flag::cmsg_cloexec on Linux to receive them close-on-exec.
+  result<received_fds> receive(byte_span payload, span<file_descriptor> fds,
+                               message_flag flags) noexcept;
+
+ private:
+  using fd_reader = int (*)(const void *batch, std::size_t i) noexcept;
+
+  result<std::size_t> send_fds(const void *batch, std::size_t fd_count, fd_reader fd_at,
+                               byte_cspan payload, message_flag flags) noexcept;
+
+  socket socket_{};
+};
+
+}  // namespace pposix
@@ -11,6 +11,7 @@
 #include "pposix/file_descriptor.hpp"
 #include "pposix/platform.hpp"
 #include "pposix/result.hpp"
+#include "pposix/span.hpp"
 #include "pposix/stat.hpp"
 #include "pposix/util.hpp"
 
@@ -56,6 +57,8 @@ class file {
                             [](const raw_fd &fd) { return file{fd}; });
   }
 
+  raw_fd fd() const noexcept { return *fd_; }
+
   std::error_code close() noexcept;
 
   result<off_t> lseek(off_t offset, file_seek wh) noexcept;
@@ -63,6 +66,11 @@ class file {
   result<ssize_t> read(byte_span buffer) noexcept;
   result<ssize_t> write(byte_cspan buffer) noexcept;
 
+  // Scatter/gather versions of read and write; the buffers are passed to the kernel as an iovec
+  // array without copying.
+  result<ssize_t> readv(span<byte_span> buffers) noexcept;
+  result<ssize_t> writev(cspan<byte_cspan> buffers) noexcept;
+
  private:
   file_descriptor fd_{};
 };
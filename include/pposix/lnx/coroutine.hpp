@@ -0,0 +1,281 @@
+#pragma once
+
+#include "pposix/extension.hpp"
+
+#if !PPOSIX_COROUTINES_ENABLED
+#error "pposix/lnx/coroutine.hpp requires a C++20 build with PPOSIX_COROUTINES enabled"
+#endif
+
+#include <coroutine>
+#include <exception>
+#include <optional>
+#include <system_error>
+#include <type_traits>
+#include <utility>
+
+#include "pposix/duration.hpp"
+#include "pposix/errno.hpp"
+#include "pposix/file_descriptor.hpp"
+#include "pposix/lnx/epoll.hpp"
+#include "pposix/lnx/reactor.hpp"
+#include "pposix/lnx/timer_wheel.hpp"
+
+namespace pposix::lnx {
+
+template <class T = void>
+class task;
+
+void spawn(task<void> t) noexcept;
+
+namespace detail {
+
+class task_promise_base {
+ public:
+  struct final_awaiter {
+    bool await_ready() const noexcept { return false; }
+
+    // Resume whoever awaited the task; a spawned task has nobody to resume and frees itself.
+    template <class Promise>
+    std::coroutine_handle<> await_suspend(std::coroutine_handle<Promise> handle) noexcept {
+      task_promise_base &promise{handle.promise()};
+      if (promise.continuation_) {
+        return promise.continuation_;
+      }
+
+      if (promise.detached_) {
+        handle.destroy();
+      }
+
+      return std::noop_coroutine();
+    }
+
+    void await_resume() const noexcept {}
+  };
+
+  std::suspend_always initial_suspend() const noexcept { return {}; }
+
+  final_awaiter final_suspend() const noexcept { return {}; }
+
+  // Nothing in pposix throws, so an exception escaping a task is a bug.
+  void unhandled_exception() const noexcept { std::terminate(); }
+
+ private:
+  template <class>
+  friend class lnx::task;
+
+  friend void lnx::spawn(task<void> t) noexcept;
+
+  std::coroutine_handle<> continuation_{};
+  bool detached_{false};
+};
+
+template <class T>
+class task_result {
+ public:
+  template <class U>
+  void return_value(U &&value) noexcept(std::is_nothrow_constructible_v<T, U &&>) {
+    value_.emplace(std::forward<U>(value));
+  }
+
+  T take() noexcept(std::is_nothrow_move_constructible_v<T>) { return std::move(*value_); }
+
+ private:
+  std::optional<T> value_{};
+};
+
+template <>
+class task_result<void> {
+ public:
+  void return_void() const noexcept {}
+
+  void take() const noexcept {}
+};
+
+}  // namespace detail
+
+// A lazily started coroutine. The body runs when the task is awaited (or spawned) and the awaiting
+// coroutine is resumed directly when it finishes, without going through the reactor.
+template <class T>
+class [[nodiscard]] task {
+ public:
+  class promise_type : public detail::task_promise_base, public detail::task_result<T> {
+   public:
+    task get_return_object() noexcept {
+      return task{std::coroutine_handle<promise_type>::from_promise(*this)};
+    }
+  };
+
+  task() noexcept = default;
+
+  task(const task &) = delete;
+  task(task &&other) noexcept : handle_{std::exchange(other.handle_, nullptr)} {}
+
+  task &operator=(const task &) = delete;
+  task &operator=(task &&other) noexcept {
+    if (this != &other) {
+      destroy();
+      handle_ = std::exchange(other.handle_, nullptr);
+    }
+
+    return *this;
+  }
+
+  ~task() { destroy(); }
+
+  bool done() const noexcept { return not handle_ or handle_.done(); }
+
+  bool await_ready() const noexcept { return done(); }
+
+  std::coroutine_handle<> await_suspend(const std::coroutine_handle<> awaiting) noexcept {
+    handle_.promise().continuation_ = awaiting;
+    return handle_;
+  }
+
+  // An empty (default constructed or moved from) task is ready at once. There is nothing to
+  // resume it with, so awaiting one is only valid for task<void>.
+  T await_resume() {
+    if (not handle_) {
+      if constexpr (std::is_void_v<T>) {
+        return;
+      } else {
+        std::terminate();
+      }
+    }
+
+    return handle_.promise().take();
+  }
+
+ private:
+  friend void spawn(task<void> t) noexcept;
+
+  explicit task(const std::coroutine_handle<promise_type> handle) noexcept : handle_{handle} {}
+
+  void destroy() noexcept {
+    if (handle_) {
+      handle_.destroy();
+      handle_ = nullptr;
+    }
+  }
+
+  std::coroutine_handle<promise_type> handle_{};
+};
+
+// Start a task that nobody awaits. It runs until its first suspension before spawn returns and
+// frees itself when it finishes.
+inline void spawn(task<void> t) noexcept {
+  if (t.done()) {
+    return;
+  }
+
+  const auto handle{std::exchange(t.handle_, nullptr)};
+  handle.promise().detached_ = true;
+  handle.resume();
+}
+
+namespace detail {
+
+// Suspends until the descriptor is ready. The awaiter lives in the coroutine frame and is the
+// reactor_handler registered for the descriptor, so an await allocates nothing and resuming is a
+// single virtual call. The descriptor is registered for the duration of the await only: it is
+// added when the coroutine suspends and removed when the event fires, or when the task is
+// destroyed while still waiting, so the event cannot reach a freed frame. An epoll registration
+// holds a single handler, so a descriptor already registered with the reactor (by another pending
+// await, e.g. readable and writable at once, or by a handler) is rejected with EBUSY rather than
+// taken over, which would leave the first waiter suspended forever.
+template <class Events>
+class readiness_awaiter final : public reactor_handler {
+ public:
+  readiness_awaiter(reactor &r, const raw_fd fd) noexcept : reactor_{r}, fd_{fd} {}
+
+  readiness_awaiter(const readiness_awaiter &) = delete;
+  readiness_awaiter &operator=(const readiness_awaiter &) = delete;
+
+  ~readiness_awaiter() override {
+    if (armed_) {
+      (void)reactor_.remove(fd_);
+    }
+  }
+
+  bool await_ready() const noexcept { return false; }
+
+  bool await_suspend(const std::coroutine_handle<> handle) noexcept {
+    handle_ = handle;
+
+    error_ = reactor_.add(fd_, Events{}, *this);
+    if (error_ == std::errc::file_exists) {
+      error_ = make_errno_code(std::errc::device_or_resource_busy);
+    }
+
+    armed_ = not error_;
+    return armed_;
+  }
+
+  // Empty once the descriptor is ready (or has hung up or failed, which the next I/O call on it
+  // reports); otherwise the error that prevented waiting for it, EBUSY if it was already
+  // registered.
+  std::error_code await_resume() const noexcept { return error_; }
+
+  // Removed before resuming: the resumed coroutine may finish and free the awaiter, or await the
+  // descriptor again.
+  void on_event(const epoll_event & /*event*/) noexcept override {
+    armed_ = false;
+    (void)reactor_.remove(fd_);
+    handle_.resume();
+  }
+
+ private:
+  reactor &reactor_;
+  raw_fd fd_;
+  std::coroutine_handle<> handle_{};
+  std::error_code error_{};
+  bool armed_{false};
+};
+
+class sleep_awaiter final : public timer {
+ public:
+  sleep_awaiter(timer_wheel &wheel, const nanoseconds delay) noexcept
+      : wheel_{wheel}, delay_{delay} {}
+
+  bool await_ready() const noexcept { return delay_.count() <= 0; }
+
+  bool await_suspend(const std::coroutine_handle<> handle) noexcept {
+    handle_ = handle;
+    error_ = wheel_.schedule(*this, delay_);
+    return not error_;
+  }
+
+  std::error_code await_resume() const noexcept { return error_; }
+
+  void on_expire() noexcept override { handle_.resume(); }
+
+ private:
+  timer_wheel &wheel_;
+  nanoseconds delay_;
+  std::coroutine_handle<> handle_{};
+  std::error_code error_{};
+};
+
+}  // namespace detail
+
+// Wait until fd is readable. At most one await per descriptor may be pending at a time and the
+// descriptor must not be registered with the reactor otherwise; see readiness_awaiter.
+//
+// Bind the result before testing it (const auto error = co_await readable(r, fd)): GCC 12
+// destroys the awaiter when the coroutine suspends if the co_await is itself the condition of an
+// if, which removes the registration (or cancels the sleep) and the coroutine is never resumed.
+inline auto readable(reactor &r, const raw_fd fd) noexcept {
+  return detail::readiness_awaiter<decltype(epoll_read_available | epoll_one_shot)>{r, fd};
+}
+
+// Wait until fd is writable. The same restrictions as for readable apply.
+inline auto writable(reactor &r, const raw_fd fd) noexcept {
+  return detail::readiness_awaiter<decltype(epoll_write_available | epoll_one_shot)>{r, fd};
+}
+
+// Wait for at least delay, rounded up to the wheel's tick. The same advice as for readable
+// applies to testing the result.
+inline detail::sleep_awaiter sleep_for(timer_wheel &wheel, const nanoseconds delay) noexcept {
+  return detail::sleep_awaiter{wheel, delay};
+}
+
+}  // namespace pposix::lnx
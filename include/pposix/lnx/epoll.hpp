@@ -3,12 +3,16 @@
 #include <sys/epoll.h>
 
 #include <cstddef>
+#include <cstdint>
+#include <system_error>
+#include <vector>
 
 #include "pposix/duration.hpp"
 #include "pposix/file_descriptor.hpp"
 #include "pposix/result.hpp"
 #include "pposix/signal.hpp"
 #include "pposix/span.hpp"
+#include "pposix/time.hpp"
 #include "pposix/util.hpp"
 
 namespace pposix::lnx {
@@ -149,6 +153,38 @@ class epoll_event final : public ::epoll_event {
   }
 };
 
+// Counters for the interest list updates recorded with epoll::defer_ctl. Every deferred update
+// that was collapsed into another one (or cancelled out) is an epoll_ctl system call saved.
+struct epoll_ctl_stats {
+  uint64_t deferred{};
+  uint64_t issued{};
+
+  // Deferred updates the kernel rejected, and the most recent of them.
+  uint64_t failed{};
+  raw_fd_t last_failed_fd{-1};
+  std::error_code last_error{};
+
+  constexpr uint64_t saved() const noexcept { return deferred - issued; }
+};
+
+namespace detail {
+
+struct epoll_interest {
+  enum class intent : uint8_t { none, add, modify };
+
+  capi::epoll_event committed{};
+  capi::epoll_event desired{};
+  intent pending{intent::none};
+  bool dirty{false};
+  bool registered{false};
+  bool removed{false};
+};
+
+}  // namespace detail
+
+// ctl() goes straight to the kernel and touches no state in this object, so it is safe to call
+// from any thread, including while another thread waits. defer_ctl(), flush() and the waits share
+// the deferred update state and must all be called from the thread that waits.
 class epoll {
  public:
   epoll() noexcept = default;
@@ -176,12 +212,52 @@ class epoll {
 
   std::error_code ctl(epoll_modify mod) noexcept;
 
+  // Record an interest list update without making a system call. Pending updates for the same
+  // descriptor are collapsed, and a modification that leaves the kernel's interest unchanged is
+  // dropped. Everything pending is applied by flush(), which the waits call first.
+  //
+  // Only deferred updates are tracked, so a descriptor should be managed either with ctl() or
+  // with defer_ctl(), not both: a deferred modify is compared against what the last flush applied.
+  //
+  // A deferred remove that finds the descriptor already gone is not an error: closing a descriptor
+  // takes it out of the interest list, so the usual defer_ctl(epoll_remove{fd}) then close(fd)
+  // makes the later epoll_ctl fail with EBADF, or ENOENT if the number has been reused since.
+  std::error_code defer_ctl(epoll_add add) noexcept;
+
+  std::error_code defer_ctl(epoll_remove remove) noexcept;
+
+  std::error_code defer_ctl(epoll_modify mod) noexcept;
+
+  // Apply every pending update. All of them are attempted; the first error is returned and every
+  // failure is counted in ctl_stats(). The waits flush too but do not fail because of it.
+  std::error_code flush() noexcept;
+
+  const epoll_ctl_stats &ctl_stats() const noexcept { return ctl_stats_; }
+
   result<int> wait(span<lnx::epoll_event>, milliseconds timeout) noexcept;
 
   result<int> pwait(span<lnx::epoll_event>, milliseconds timeout, const sigset &sigmask) noexcept;
 
+  // Like pwait but with a nanosecond resolution timeout; a negative timeout blocks indefinitely.
+  // Uses epoll_pwait2 when the kernel has it (5.11+) and otherwise falls back to epoll_pwait with
+  // the timeout rounded up to whole milliseconds.
+  result<int> pwait2(span<lnx::epoll_event>, nanoseconds timeout, const sigset &sigmask) noexcept;
+
+  result<int> pwait2(span<lnx::epoll_event>, const timespec &timeout,
+                     const sigset &sigmask) noexcept;
+
  private:
+  result<int> unsafe_pwait2(span<lnx::epoll_event> events, const ::timespec *timeout,
+                            const sigset &sigmask) noexcept;
+
+  detail::epoll_interest &deferred_interest(raw_fd fd) noexcept;
+
   file_descriptor epoll_fd_{};
+
+  // Interest list state, indexed by descriptor number.
+  std::vector<detail::epoll_interest> interest_{};
+  std::vector<raw_fd_t> dirty_{};
+  epoll_ctl_stats ctl_stats_{};
 };
 
 }  // namespace pposix::lnx
@@ -0,0 +1,64 @@
+#pragma once
+
+#include <sys/eventfd.h>
+
+#include <cstdint>
+#include <system_error>
+
+#include "pposix/file_descriptor.hpp"
+#include "pposix/result.hpp"
+#include "pposix/util.hpp"
+
+namespace pposix::lnx {
+
+namespace capi {
+
+enum class eventfd_flag : int {
+  none = 0,
+  cloexec = EFD_CLOEXEC,
+  nonblock = EFD_NONBLOCK,
+  semaphore = EFD_SEMAPHORE,
+};
+
+}  // namespace capi
+
+template <capi::eventfd_flag Flag>
+using eventfd_flag = enum_flag<capi::eventfd_flag, Flag>;
+
+inline constexpr eventfd_flag<capi::eventfd_flag::none> eventfd_default{};
+inline constexpr eventfd_flag<capi::eventfd_flag::cloexec> eventfd_cloexec{};
+inline constexpr eventfd_flag<capi::eventfd_flag::nonblock> eventfd_nonblock{};
+inline constexpr eventfd_flag<capi::eventfd_flag::semaphore> eventfd_semaphore{};
+
+class eventfd {
+ public:
+  eventfd() noexcept = default;
+
+  explicit eventfd(raw_fd fd) noexcept;
+
+  eventfd(const eventfd &) = delete;
+  eventfd(eventfd &&) noexcept = default;
+
+  eventfd &operator=(const eventfd &) = delete;
+  eventfd &operator=(eventfd &&) noexcept = default;
+
+  static result<eventfd> unsafe_create(unsigned initial_value, capi::eventfd_flag flags) noexcept;
+
+  template <capi::eventfd_flag Flags>
+  static result<eventfd> create(const unsigned initial_value, eventfd_flag<Flags>) noexcept {
+    return unsafe_create(initial_value, Flags);
+  }
+
+  raw_fd fd() const noexcept { return *fd_; }
+
+  // Add value to the counter, waking up anyone waiting for the descriptor to become readable.
+  std::error_code write(uint64_t value) noexcept;
+
+  // Read and reset the counter (or decrement it by one in semaphore mode).
+  result<uint64_t> read() noexcept;
+
+ private:
+  file_descriptor fd_{};
+};
+
+}  // namespace pposix::lnx
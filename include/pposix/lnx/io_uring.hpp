@@ -0,0 +1,164 @@
+#pragma once
+
+#include <linux/io_uring.h>
+#include <sys/types.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <system_error>
+
+#include "pposix/byte_span.hpp"
+#include "pposix/file_descriptor.hpp"
+#include "pposix/mman.hpp"
+#include "pposix/result.hpp"
+#include "pposix/socket.hpp"
+#include "pposix/span.hpp"
+#include "pposix/util.hpp"
+
+namespace pposix::lnx {
+
+namespace capi {
+
+enum class io_uring_setup_flag : uint32_t {
+  none = 0u,
+  iopoll = IORING_SETUP_IOPOLL,
+  sqpoll = IORING_SETUP_SQPOLL,
+  clamp = IORING_SETUP_CLAMP,
+};
+
+enum class io_uring_op : uint8_t {
+  nop = IORING_OP_NOP,
+  read = IORING_OP_READ,
+  write = IORING_OP_WRITE,
+  accept = IORING_OP_ACCEPT,
+  recv = IORING_OP_RECV,
+  send = IORING_OP_SEND,
+};
+
+}  // namespace capi
+
+template <capi::io_uring_setup_flag Flag>
+using io_uring_setup_flag = enum_flag<capi::io_uring_setup_flag, Flag>;
+
+inline constexpr io_uring_setup_flag<capi::io_uring_setup_flag::none> io_uring_default{};
+inline constexpr io_uring_setup_flag<capi::io_uring_setup_flag::iopoll> io_uring_iopoll{};
+inline constexpr io_uring_setup_flag<capi::io_uring_setup_flag::sqpoll> io_uring_sqpoll{};
+inline constexpr io_uring_setup_flag<capi::io_uring_setup_flag::clamp> io_uring_clamp{};
+
+// Passing this offset to io_uring::read or io_uring::write uses (and advances) the current file
+// position, which is what pipes and other non-seekable descriptors require.
+inline constexpr off_t io_uring_current_offset{-1};
+
+class io_uring_completion {
+ public:
+  constexpr io_uring_completion() noexcept = default;
+
+  constexpr io_uring_completion(uint64_t user_data, int res, uint32_t flags) noexcept
+      : user_data_{user_data}, res_{res}, flags_{flags} {}
+
+  constexpr uint64_t user_data() const noexcept { return user_data_; }
+  constexpr uint32_t flags() const noexcept { return flags_; }
+
+  // The result of the completed operation, e.g. the number of bytes transferred or the accepted
+  // descriptor. Failed operations are reported by the kernel as -errno.
+  result<int> res() const noexcept {
+    if (res_ < 0) {
+      return make_errno_code(std::errc{-res_});
+    } else {
+      return res_;
+    }
+  }
+
+ private:
+  uint64_t user_data_{};
+  int res_{};
+  uint32_t flags_{};
+};
+
+class io_uring {
+ public:
+  io_uring() noexcept = default;
+
+  io_uring(const io_uring &) = delete;
+  io_uring(io_uring &&) noexcept = default;
+
+  io_uring &operator=(const io_uring &) = delete;
+  io_uring &operator=(io_uring &&) noexcept = default;
+
+  static result<io_uring> unsafe_create(unsigned entries,
+                                        capi::io_uring_setup_flag flags) noexcept;
+
+  template <capi::io_uring_setup_flag Flags>
+  static result<io_uring> create(unsigned entries, io_uring_setup_flag<Flags>) noexcept {
+    static_assert(not(io_uring_setup_flag<Flags>::has(io_uring_iopoll) and
+                      io_uring_setup_flag<Flags>::has(io_uring_sqpoll)),
+                  "'io_uring_iopoll' and 'io_uring_sqpoll' are not supported together.");
+
+    return unsafe_create(entries, Flags);
+  }
+
+  static result<io_uring> create(unsigned entries) noexcept;
+
+  raw_fd fd() const noexcept { return *ring_fd_; }
+
+  unsigned submission_capacity() const noexcept { return sq_entries_; }
+  unsigned completion_capacity() const noexcept { return cq_entries_; }
+
+  // Number of submission queue entries that have been prepared but not yet consumed by the kernel.
+  unsigned pending() const noexcept;
+
+  // Queue operations. No system call is made until submit() is called. If the submission queue is
+  // full std::errc::resource_unavailable_try_again is returned and nothing is queued.
+  std::error_code nop(uint64_t user_data) noexcept;
+  std::error_code read(raw_fd fd, byte_span buffer, off_t offset, uint64_t user_data) noexcept;
+  std::error_code write(raw_fd fd, byte_cspan buffer, off_t offset, uint64_t user_data) noexcept;
+  std::error_code accept(socket_fd fd, socket_flag flags, uint64_t user_data) noexcept;
+  std::error_code recv(socket_fd fd, byte_span buffer, uint64_t user_data) noexcept;
+  std::error_code send(socket_fd fd, byte_cspan buffer, uint64_t user_data) noexcept;
+
+  // Submit every queued operation with a single io_uring_enter call.
+  result<int> submit() noexcept;
+
+  // Submit every queued operation and block until at least min_complete completions are available.
+  result<int> submit_and_wait(unsigned min_complete) noexcept;
+
+  // Copy available completions into the buffer and release them back to the kernel. This never
+  // makes a system call; use submit_and_wait to block for completions.
+  std::size_t reap(span<io_uring_completion> completions) noexcept;
+
+ private:
+  io_uring(file_descriptor ring_fd, unique_mmap_d sq_ring, unique_mmap_d cq_ring,
+           unique_mmap_d sqes, const ::io_uring_params &params) noexcept;
+
+  ::io_uring_sqe *next_sqe() noexcept;
+
+  result<int> enter(unsigned to_submit, unsigned min_complete, unsigned flags) noexcept;
+
+  file_descriptor ring_fd_{};
+
+  // The completion ring shares the submission ring mapping on kernels with
+  // IORING_FEAT_SINGLE_MMAP, in which case cq_ring_ stays empty.
+  unique_mmap_d sq_ring_{};
+  unique_mmap_d cq_ring_{};
+  unique_mmap_d sqes_{};
+
+  uint32_t setup_flags_{};
+  unsigned sq_entries_{};
+  unsigned cq_entries_{};
+
+  // Submission queue
+  unsigned *sq_head_{nullptr};
+  unsigned *sq_tail_{nullptr};
+  unsigned *sq_mask_{nullptr};
+  unsigned *sq_flags_{nullptr};
+  ::io_uring_sqe *sqe_array_{nullptr};
+  unsigned sqe_tail_{};
+
+  // Completion queue
+  unsigned *cq_head_{nullptr};
+  unsigned *cq_tail_{nullptr};
+  unsigned *cq_mask_{nullptr};
+  ::io_uring_cqe *cqe_array_{nullptr};
+};
+
+}  // namespace pposix::lnx
@@ -0,0 +1,197 @@
+#pragma once
+
+#include <linux/if_packet.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <optional>
+#include <system_error>
+
+#include "pposix/byte_span.hpp"
+#include "pposix/duration.hpp"
+#include "pposix/file_descriptor.hpp"
+#include "pposix/mman.hpp"
+#include "pposix/result.hpp"
+#include "pposix/socket.hpp"
+#include "pposix/time.hpp"
+
+namespace pposix::lnx {
+
+// One captured frame, in place in the ring.
+class packet_frame {
+ public:
+  constexpr explicit packet_frame(const ::tpacket3_hdr *header) noexcept : header_{header} {}
+
+  // The captured bytes, starting at the link layer header.
+  byte_cspan data() const noexcept {
+    return byte_cspan{reinterpret_cast<const std::byte *>(header_) + header_->tp_mac,
+                      header_->tp_snaplen};
+  }
+
+  // The length of the frame on the wire, which is more than data() holds if it was truncated.
+  uint32_t wire_length() const noexcept { return header_->tp_len; }
+
+  bool truncated() const noexcept { return header_->tp_snaplen < header_->tp_len; }
+
+  // tp_sec is unsigned 32-bit; going through the int rep of pposix::seconds would wrap in 2038.
+  pposix::timespec timestamp() const noexcept {
+    pposix::timespec time{};
+    time.tv_sec = static_cast<::time_t>(header_->tp_sec);
+    time.tv_nsec = static_cast<long>(header_->tp_nsec);
+    return time;
+  }
+
+  // The interface, link layer protocol and direction (PACKET_HOST, PACKET_OUTGOING, ...) of the
+  // frame.
+  const ::sockaddr_ll &address() const noexcept {
+    return *reinterpret_cast<const ::sockaddr_ll *>(reinterpret_cast<const std::byte *>(header_) +
+                                                    TPACKET_ALIGN(sizeof(::tpacket3_hdr)));
+  }
+
+  const ::tpacket3_hdr &get() const noexcept { return *header_; }
+
+ private:
+  const ::tpacket3_hdr *header_;
+};
+
+// A block of frames that the kernel has handed over. The frames are only valid until the block is
+// released, which gives the memory back to the kernel to fill again; destroying the block releases
+// it.
+class packet_block {
+ public:
+  class iterator {
+   public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = packet_frame;
+    using difference_type = std::ptrdiff_t;
+    using pointer = void;
+    using reference = packet_frame;
+
+    constexpr iterator() noexcept = default;
+
+    packet_frame operator*() const noexcept { return packet_frame{header_}; }
+
+    iterator &operator++() noexcept {
+      header_ = --remaining_ == 0u ? nullptr
+                                   : reinterpret_cast<const ::tpacket3_hdr *>(
+                                         reinterpret_cast<const std::byte *>(header_) +
+                                         header_->tp_next_offset);
+      return *this;
+    }
+
+    iterator operator++(int) noexcept {
+      iterator previous{*this};
+      ++*this;
+      return previous;
+    }
+
+    constexpr bool operator==(const iterator &other) const noexcept {
+      return header_ == other.header_;
+    }
+
+    constexpr bool operator!=(const iterator &other) const noexcept { return not(*this == other); }
+
+   private:
+    friend class packet_block;
+
+    constexpr iterator(const ::tpacket3_hdr *header, const uint32_t remaining) noexcept
+        : header_{header}, remaining_{remaining} {}
+
+    const ::tpacket3_hdr *header_{nullptr};
+    uint32_t remaining_{0u};
+  };
+
+  explicit packet_block(::tpacket_block_desc *block) noexcept : block_{block} {}
+
+  packet_block(const packet_block &) = delete;
+  packet_block(packet_block &&other) noexcept;
+
+  packet_block &operator=(const packet_block &) = delete;
+  packet_block &operator=(packet_block &&other) noexcept;
+
+  ~packet_block() { release(); }
+
+  iterator begin() const noexcept;
+  iterator end() const noexcept { return {}; }
+
+  // Number of frames in the block; zero once it has been released or moved from.
+  std::size_t size() const noexcept { return block_ == nullptr ? 0u : block_->hdr.bh1.num_pkts; }
+
+  // The block was handed over because the retire timeout expired before it filled up.
+  bool timed_out() const noexcept {
+    return block_ != nullptr and (block_->hdr.bh1.block_status & TP_STATUS_BLK_TMO) != 0u;
+  }
+
+  void release() noexcept;
+
+ private:
+  ::tpacket_block_desc *block_;
+};
+
+struct packet_ring_config {
+  // Size of each block, a multiple of the page size. A block is handed over when it is full or
+  // when block_timeout expires, whichever comes first.
+  std::size_t block_size{std::size_t{1u} << 20u};
+  std::size_t block_count{64u};
+
+  // Frames are packed into blocks at their actual size; frame_size only sets the frame count the
+  // kernel checks the ring against.
+  std::size_t frame_size{2048u};
+
+  milliseconds block_timeout{10};
+};
+
+// Receive counters since the previous call to stats().
+struct packet_ring_stats {
+  uint32_t packets{};
+  uint32_t drops{};
+
+  // Times the kernel found the ring full because no block had been released.
+  uint32_t freezes{};
+};
+
+// A packet socket with a TPACKET_V3 receive ring: the kernel writes frames straight into blocks of
+// memory shared with the process, which walks them in place with no system call or copy per frame.
+// Requires CAP_NET_RAW.
+//
+// To wait for blocks with epoll (or a reactor), register fd() for epoll_read_available; it becomes
+// readable when the kernel hands a block over. Then call next() until it returns nothing.
+class packet_ring {
+ public:
+  packet_ring() noexcept = default;
+
+  packet_ring(const packet_ring &) = delete;
+  packet_ring(packet_ring &&) noexcept = default;
+
+  packet_ring &operator=(const packet_ring &) = delete;
+  packet_ring &operator=(packet_ring &&) noexcept = default;
+
+  // Set up the ring for a packet socket receiving the given link layer protocol (ETH_P_*, in host
+  // byte order). It receives nothing until bound.
+  static result<packet_ring> create(const packet_ring_config &config, uint16_t protocol,
+                                    socket_flag flags) noexcept;
+
+  // Capture from one interface (e.g. if_nametoindex("lo")), or from every interface with zero.
+  std::error_code bind(unsigned interface_index) noexcept;
+
+  raw_fd fd() const noexcept { return raw_fd{static_cast<raw_fd_t>(socket_.fd())}; }
+
+  // The next block, if the kernel has finished filling it. Blocks come back in ring order; the
+  // kernel drops frames once it reaches a block that has not been released.
+  std::optional<packet_block> next() noexcept;
+
+  result<packet_ring_stats> stats() noexcept;
+
+ private:
+  packet_ring(socket s, mmap map, const packet_ring_config &config, uint16_t protocol) noexcept;
+
+  socket socket_{};
+  mmap map_{};
+  std::size_t block_size_{0u};
+  std::size_t block_count_{0u};
+  std::size_t current_{0u};
+  uint16_t protocol_{0u};
+};
+
+}  // namespace pposix::lnx
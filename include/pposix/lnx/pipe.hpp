@@ -0,0 +1,58 @@
+#pragma once
+
+#include <fcntl.h>
+
+#include <cstddef>
+#include <system_error>
+
+#include "pposix/file_descriptor.hpp"
+#include "pposix/result.hpp"
+#include "pposix/util.hpp"
+
+namespace pposix::lnx {
+
+enum class pipe_flag : int {
+  none = 0,
+  cloexec = O_CLOEXEC,
+  nonblock = O_NONBLOCK,
+  // Packet mode: each write is read back as a separate message.
+  direct = O_DIRECT,
+};
+
+constexpr pipe_flag operator|(const pipe_flag lhs, const pipe_flag rhs) noexcept {
+  return pipe_flag{underlying_v(lhs) | underlying_v(rhs)};
+}
+
+// Both ends of a pipe. Besides ordinary reads and writes, a pipe is the kernel buffer that
+// splice, tee and vmsplice move pages through.
+class pipe {
+ public:
+  pipe() noexcept = default;
+
+  pipe(const pipe &) = delete;
+  pipe(pipe &&) noexcept = default;
+
+  pipe &operator=(const pipe &) = delete;
+  pipe &operator=(pipe &&) noexcept = default;
+
+  static result<pipe> create(pipe_flag flags) noexcept;
+
+  raw_fd read_fd() const noexcept { return *read_fd_; }
+  raw_fd write_fd() const noexcept { return *write_fd_; }
+
+  // The number of bytes the pipe can hold before writes block.
+  result<std::size_t> capacity() const noexcept;
+
+  // Resize the pipe. The kernel rounds the size up to a power of two number of pages and fails
+  // with operation_not_permitted above /proc/sys/fs/pipe-max-size for unprivileged processes.
+  // Returns the new capacity.
+  result<std::size_t> set_capacity(std::size_t size) noexcept;
+
+ private:
+  pipe(raw_fd read_fd, raw_fd write_fd) noexcept;
+
+  file_descriptor read_fd_{};
+  file_descriptor write_fd_{};
+};
+
+}  // namespace pposix::lnx
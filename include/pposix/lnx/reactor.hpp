@@ -0,0 +1,98 @@
+#pragma once
+
+#include <cstddef>
+#include <system_error>
+#include <vector>
+
+#include "pposix/duration.hpp"
+#include "pposix/file_descriptor.hpp"
+#include "pposix/lnx/epoll.hpp"
+#include "pposix/result.hpp"
+#include "pposix/util.hpp"
+
+namespace pposix::lnx {
+
+// Base class for objects that receive readiness notifications from a reactor. The reactor stores a
+// pointer to the handler in the epoll event data, so dispatching an event is a single virtual call
+// with no lookup. A handler must outlive its registration and must not be destroyed while
+// reactor::run_once is dispatching, even if it removed itself.
+class reactor_handler {
+ public:
+  reactor_handler() noexcept = default;
+
+  reactor_handler(const reactor_handler &) = delete;
+  reactor_handler(reactor_handler &&) = delete;
+
+  reactor_handler &operator=(const reactor_handler &) = delete;
+  reactor_handler &operator=(reactor_handler &&) = delete;
+
+  virtual ~reactor_handler() = default;
+
+  // Called once per event. The default calls on_error, on_read, on_write and on_hup, in that
+  // order, for each condition the event reports; override it to handle the event as a whole, e.g.
+  // when handling it may destroy the handler.
+  virtual void on_event(const epoll_event &event) noexcept;
+
+  virtual void on_read() noexcept {}
+  virtual void on_write() noexcept {}
+  virtual void on_hup() noexcept {}
+  virtual void on_error() noexcept {}
+};
+
+// Busy polling for reactor::run_once: before blocking, poll epoll with a zero timeout until an
+// event arrives or the budget is spent. Trades CPU for wakeup latency; combine it with
+// socket_busy_poll so the polls also spin on the device queues of the registered sockets.
+struct reactor_spin_policy {
+  nanoseconds budget{0};
+};
+
+class reactor {
+ public:
+  reactor() noexcept = default;
+
+  reactor(const reactor &) = delete;
+  reactor(reactor &&) noexcept = default;
+
+  reactor &operator=(const reactor &) = delete;
+  reactor &operator=(reactor &&) noexcept = default;
+
+  // Create a reactor that dispatches at most max_events events per call to run_once. The event
+  // buffer is allocated once here and reused by every run_once call; fails with not_enough_memory
+  // if it cannot be allocated.
+  static result<reactor> create(std::size_t max_events) noexcept;
+
+  template <capi::epoll_event_flag Flags>
+  std::error_code add(const raw_fd fd, epoll_event_flag<Flags>,
+                      reactor_handler &handler) noexcept {
+    return epoll_.ctl(epoll_add{fd, capi::epoll_event{Flags, static_cast<void *>(&handler)}});
+  }
+
+  template <capi::epoll_event_flag Flags>
+  std::error_code modify(const raw_fd fd, const epoll_event_flag<Flags> flags,
+                         reactor_handler &handler) noexcept {
+    return epoll_.ctl(epoll_modify{fd, flags, static_cast<void *>(&handler)});
+  }
+
+  std::error_code remove(raw_fd fd) noexcept;
+
+  // Wait up to timeout for events and dispatch them to their handlers. Returns the number of
+  // events dispatched. Time spent spinning under the spin policy counts towards the timeout.
+  result<int> run_once(milliseconds timeout) noexcept;
+
+  void set_spin_policy(reactor_spin_policy policy) noexcept { spin_ = policy; }
+
+  reactor_spin_policy spin_policy() const noexcept { return spin_; }
+
+  lnx::epoll &epoll() noexcept { return epoll_; }
+
+ private:
+  reactor(lnx::epoll ep, std::vector<epoll_event> events) noexcept;
+
+  result<int> wait(milliseconds timeout) noexcept;
+
+  lnx::epoll epoll_{};
+  std::vector<epoll_event> events_{};
+  reactor_spin_policy spin_{};
+};
+
+}  // namespace pposix::lnx
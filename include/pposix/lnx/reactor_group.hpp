@@ -0,0 +1,83 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <system_error>
+#include <vector>
+
+#include "pposix/file_descriptor.hpp"
+#include "pposix/lnx/epoll.hpp"
+#include "pposix/lnx/reactor.hpp"
+#include "pposix/lnx/task_queue.hpp"
+#include "pposix/result.hpp"
+
+namespace pposix::lnx {
+
+enum class reactor_affinity { none, pin_to_cpu };
+
+class reactor_shard;
+
+// A set of reactors, each driven by its own thread with its own epoll instance. Descriptors shared
+// between shards (typically listening sockets) are registered with epoll_exclusive so the kernel
+// wakes a single shard per event instead of every waiting thread.
+class reactor_group {
+ public:
+  reactor_group() noexcept;
+  ~reactor_group();
+
+  reactor_group(const reactor_group &) = delete;
+  reactor_group(reactor_group &&) noexcept;
+
+  reactor_group &operator=(const reactor_group &) = delete;
+  reactor_group &operator=(reactor_group &&) noexcept;
+
+  // Fails with not_enough_memory if the shards cannot be allocated.
+  static result<reactor_group> create(std::size_t shard_count,
+                                      std::size_t max_events_per_shard) noexcept;
+
+  // Create one shard per hardware thread.
+  static result<reactor_group> create(std::size_t max_events_per_shard) noexcept;
+
+  std::size_t size() const noexcept { return shards_.size(); }
+
+  reactor &shard(std::size_t index) noexcept;
+
+  // Register fd with every shard. The handler is invoked from whichever shard thread the kernel
+  // chose to wake, so it has to be safe to call concurrently. If any shard fails, fd is removed
+  // from the shards it was already added to, so it is registered with all of them or none.
+  template <capi::epoll_event_flag Flags>
+  std::error_code add_shared(const raw_fd fd, const epoll_event_flag<Flags> flags,
+                             reactor_handler &handler) noexcept {
+    static_assert(not epoll_event_flag<Flags>::has(epoll_one_shot),
+                  "epoll_one_shot cannot be combined with epoll_exclusive.");
+
+    for (std::size_t i = 0u; i < size(); ++i) {
+      if (const auto error = shard(i).add(fd, flags | epoll_exclusive, handler)) {
+        while (i > 0u) {
+          (void)shard(--i).remove(fd);
+        }
+
+        return error;
+      }
+    }
+
+    return {};
+  }
+
+  // Queue a task to run on the thread of the given shard and wake that shard.
+  std::error_code post(std::size_t shard_index, reactor_task &task) noexcept;
+
+  // Start one thread per shard. Shards block in epoll until they have work. With pin_to_cpu each
+  // thread is created already bound to its CPU. Fails with EBUSY if the group is already running.
+  std::error_code start(reactor_affinity affinity) noexcept;
+
+  // Wake every shard, wait for its thread to exit and leave the group ready to be started again.
+  void stop() noexcept;
+
+ private:
+  explicit reactor_group(std::vector<std::unique_ptr<reactor_shard>> shards) noexcept;
+
+  std::vector<std::unique_ptr<reactor_shard>> shards_{};
+};
+
+}  // namespace pposix::lnx
@@ -0,0 +1,54 @@
+#pragma once
+
+#include <sys/socket.h>
+
+#include <cstddef>
+#include <vector>
+
+#include "pposix/result.hpp"
+#include "pposix/socket.hpp"
+
+namespace pposix::lnx {
+
+// A set of listening sockets bound to the same address with SO_REUSEPORT, one per worker. A
+// classic BPF program steers every incoming connection to socket cpu % size(), where cpu is the
+// CPU that processed the packet, so a worker pinned to CPU i (see reactor_group) serves the flows
+// that arrive on it without cross-CPU traffic.
+class reuseport_group {
+ public:
+  reuseport_group() noexcept = default;
+
+  reuseport_group(const reuseport_group &) = delete;
+  reuseport_group(reuseport_group &&) noexcept = default;
+
+  reuseport_group &operator=(const reuseport_group &) = delete;
+  reuseport_group &operator=(reuseport_group &&) noexcept = default;
+
+  // Create count sockets, bind them to address in order and listen on them (for stream sockets),
+  // then attach the steering program. With port 0 the first socket picks the port and the others
+  // join it. Fails with not_enough_memory if the group cannot be allocated.
+  static result<reuseport_group> unsafe_create(socket_domain domain, socket_type type,
+                                               socket_flag flags, const ::sockaddr *address,
+                                               socklen_t length, std::size_t count,
+                                               int backlog) noexcept;
+
+  template <class Address>
+  static result<reuseport_group> create(const socket_type type, const socket_flag flags,
+                                        const Address &address, const std::size_t count,
+                                        const int backlog) noexcept {
+    return unsafe_create(address.domain(), type, flags, address.data(), address.length(), count,
+                         backlog);
+  }
+
+  std::size_t size() const noexcept { return sockets_.size(); }
+
+  // The socket that receives the flows processed on CPUs congruent to index modulo size().
+  socket &operator[](std::size_t index) noexcept { return sockets_[index]; }
+
+ private:
+  explicit reuseport_group(std::vector<socket> sockets) noexcept;
+
+  std::vector<socket> sockets_{};
+};
+
+}  // namespace pposix::lnx
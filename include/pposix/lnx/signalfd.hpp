@@ -0,0 +1,92 @@
+#pragma once
+
+#include <sys/signalfd.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <system_error>
+
+#include "pposix/file_descriptor.hpp"
+#include "pposix/result.hpp"
+#include "pposix/signal.hpp"
+#include "pposix/span.hpp"
+#include "pposix/types.hpp"
+#include "pposix/util.hpp"
+
+namespace pposix::lnx {
+
+namespace capi {
+
+enum class signalfd_flag : int { none = 0, cloexec = SFD_CLOEXEC, nonblock = SFD_NONBLOCK };
+
+}  // namespace capi
+
+template <capi::signalfd_flag Flag>
+using signalfd_flag = enum_flag<capi::signalfd_flag, Flag>;
+
+inline constexpr signalfd_flag<capi::signalfd_flag::none> signalfd_default{};
+inline constexpr signalfd_flag<capi::signalfd_flag::cloexec> signalfd_cloexec{};
+inline constexpr signalfd_flag<capi::signalfd_flag::nonblock> signalfd_nonblock{};
+
+// A signal read from a signalfd. Layout compatible with signalfd_siginfo so a span of these can be
+// read into directly.
+class signalfd_info : private ::signalfd_siginfo {
+ public:
+  signalfd_info() noexcept : ::signalfd_siginfo{} {}
+
+  sig_number signal() const noexcept { return sig_number{static_cast<int>(ssi_signo)}; }
+
+  int32_t code() const noexcept { return ssi_code; }
+
+  int32_t error() const noexcept { return ssi_errno; }
+
+  // Sending process, for signals sent with kill() or sigqueue() and for SIGCHLD.
+  pid_t pid() const noexcept { return static_cast<pid_t>(ssi_pid); }
+
+  user_id uid() const noexcept { return user_id{ssi_uid}; }
+
+  // Exit status or signal of the child for SIGCHLD.
+  int32_t status() const noexcept { return ssi_status; }
+
+  // Value sent with sigqueue().
+  int32_t int_value() const noexcept { return ssi_int; }
+
+  uint64_t ptr_value() const noexcept { return ssi_ptr; }
+};
+
+static_assert(sizeof(signalfd_info) == sizeof(::signalfd_siginfo));
+
+// Delivers signals as reads on a descriptor so they can be waited on with epoll. The signals must
+// be blocked with pthread_sigmask (in every thread) or they are still delivered the usual way.
+class signalfd {
+ public:
+  signalfd() noexcept = default;
+
+  explicit signalfd(raw_fd fd) noexcept;
+
+  signalfd(const signalfd &) = delete;
+  signalfd(signalfd &&) noexcept = default;
+
+  signalfd &operator=(const signalfd &) = delete;
+  signalfd &operator=(signalfd &&) noexcept = default;
+
+  static result<signalfd> unsafe_create(const sigset &signals, capi::signalfd_flag flags) noexcept;
+
+  template <capi::signalfd_flag Flags>
+  static result<signalfd> create(const sigset &signals, signalfd_flag<Flags>) noexcept {
+    return unsafe_create(signals, Flags);
+  }
+
+  raw_fd fd() const noexcept { return *fd_; }
+
+  // Replace the set of signals accepted by the descriptor.
+  std::error_code set_mask(const sigset &signals) noexcept;
+
+  // Read as many pending signals as fit in infos with a single read. Returns the number read.
+  result<std::size_t> read(span<signalfd_info> infos) noexcept;
+
+ private:
+  file_descriptor fd_{};
+};
+
+}  // namespace pposix::lnx
@@ -0,0 +1,100 @@
+#pragma once
+
+#include <fcntl.h>
+#include <sys/types.h>
+
+#include <cstddef>
+
+#include "pposix/byte_span.hpp"
+#include "pposix/file.hpp"
+#include "pposix/file_descriptor.hpp"
+#include "pposix/lnx/pipe.hpp"
+#include "pposix/result.hpp"
+#include "pposix/socket.hpp"
+#include "pposix/span.hpp"
+#include "pposix/util.hpp"
+
+namespace pposix::lnx {
+
+enum class splice_flag : unsigned {
+  none = 0u,
+  // Move pages rather than copying them where the kernel can.
+  move = SPLICE_F_MOVE,
+  // Do not block on the pipe; the other descriptor's own O_NONBLOCK still applies.
+  nonblock = SPLICE_F_NONBLOCK,
+  // More data follows, as with message_flag::more.
+  more = SPLICE_F_MORE,
+  // vmsplice only: the pages are handed over to the kernel and must not be touched again.
+  gift = SPLICE_F_GIFT,
+};
+
+constexpr splice_flag operator|(const splice_flag lhs, const splice_flag rhs) noexcept {
+  return splice_flag{underlying_v(lhs) | underlying_v(rhs)};
+}
+
+// Thin wrappers over the system calls. Each makes a single call and returns the number of bytes
+// moved, zero meaning end of input.
+
+// Copy from in, a file that can be mapped, to out. The offset is advanced past the bytes sent and
+// in's file position is left alone.
+result<std::size_t> sendfile(socket &out, const file &in, off_t &offset,
+                             std::size_t count) noexcept;
+
+// Move bytes between a pipe and another descriptor. At least one side must be a pipe; a null
+// offset uses (and advances) the file position, and must be null for pipes and sockets.
+result<std::size_t> splice(raw_fd in, loff_t *in_offset, raw_fd out, loff_t *out_offset,
+                           std::size_t count, splice_flag flags) noexcept;
+
+// Duplicate bytes from one pipe to another without consuming them from in.
+result<std::size_t> tee(const pipe &in, const pipe &out, std::size_t count,
+                        splice_flag flags) noexcept;
+
+// Map user memory into a pipe. Unless splice_flag::gift is given the buffers must not be modified
+// until the data has been read out of the pipe, since the pipe may reference them directly.
+result<std::size_t> vmsplice(const pipe &out, cspan<byte_cspan> buffers,
+                             splice_flag flags) noexcept;
+
+// Splices between two descriptors through a private pipe, so the data never enters user space.
+// Bytes pulled into the pipe that could not be written out yet stay there and go out first on the
+// next transfer.
+class splice_relay {
+ public:
+  splice_relay() noexcept = default;
+
+  // A capacity of zero keeps the default pipe size.
+  static result<splice_relay> create(std::size_t capacity) noexcept;
+
+  // Move up to count bytes from in to out, stopping early at end of input or when either side
+  // would block. An error after some bytes were moved is reported by the next call instead. With
+  // blocking descriptors this only returns once count bytes have moved or the input has ended.
+  result<std::size_t> transfer(raw_fd out, raw_fd in, std::size_t count) noexcept;
+
+  // Bytes read from in but not yet written to out.
+  std::size_t buffered() const noexcept { return buffered_; }
+
+ private:
+  explicit splice_relay(pipe p) noexcept;
+
+  pipe pipe_{};
+  std::size_t buffered_{0u};
+};
+
+// Move up to count bytes using the cheapest mechanism for the pair of descriptors:
+//  - file to socket: sendfile, which feeds the page cache straight to the socket;
+//  - file to file: copy_file_range, which can share extents on filesystems that support it, or
+//    sendfile across filesystems (EXDEV) and where copy_file_range is not supported;
+//  - socket to socket or socket to file: splice through the relay's pipe.
+// Each loops until count bytes are moved, the input is exhausted or a descriptor would block, and
+// has the error semantics of splice_relay::transfer.
+result<std::size_t> transfer(socket &out, const file &in, off_t &offset,
+                             std::size_t count) noexcept;
+
+result<std::size_t> transfer(file &out, const file &in, off_t &offset, std::size_t count) noexcept;
+
+result<std::size_t> transfer(socket &out, socket &in, splice_relay &relay,
+                             std::size_t count) noexcept;
+
+result<std::size_t> transfer(file &out, socket &in, splice_relay &relay,
+                             std::size_t count) noexcept;
+
+}  // namespace pposix::lnx
@@ -0,0 +1,75 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <system_error>
+
+#include "pposix/file_descriptor.hpp"
+#include "pposix/lnx/eventfd.hpp"
+#include "pposix/result.hpp"
+
+namespace pposix::lnx {
+
+class task_queue;
+
+// A unit of work handed to another thread through a task_queue. Tasks are intrusive, so posting
+// one never allocates; the task must stay alive until its run() has been called.
+class reactor_task {
+ public:
+  reactor_task() noexcept = default;
+
+  reactor_task(const reactor_task &) = delete;
+  reactor_task(reactor_task &&) = delete;
+
+  reactor_task &operator=(const reactor_task &) = delete;
+  reactor_task &operator=(reactor_task &&) = delete;
+
+  virtual ~reactor_task() = default;
+
+  virtual void run() noexcept = 0;
+
+ private:
+  friend class task_queue;
+
+  reactor_task *next_{nullptr};
+};
+
+// A lock-free multi-producer, single-consumer queue of tasks paired with an eventfd. Any thread
+// may post; the thread that owns the queue registers fd() with its epoll set and calls
+// run_pending() when it becomes readable. Only the post that finds the queue unsignalled writes
+// to the eventfd, so a burst of posts costs a single write(2) and a single wakeup.
+class task_queue {
+ public:
+  task_queue() noexcept = default;
+
+  explicit task_queue(lnx::eventfd event) noexcept;
+
+  task_queue(const task_queue &) = delete;
+
+  // Moving is only safe while no other thread is posting to either queue.
+  task_queue(task_queue &&other) noexcept;
+
+  task_queue &operator=(const task_queue &) = delete;
+  task_queue &operator=(task_queue &&other) noexcept;
+
+  static result<task_queue> create() noexcept;
+
+  raw_fd fd() const noexcept { return event_.fd(); }
+
+  std::error_code post(reactor_task &task) noexcept;
+
+  // Wake the owning thread without queueing anything.
+  std::error_code wake() noexcept;
+
+  // Run every queued task in the order it was posted. Returns the number of tasks run.
+  result<std::size_t> run_pending() noexcept;
+
+ private:
+  lnx::eventfd event_{};
+
+  // Treiber stack of posted tasks, newest first.
+  std::atomic<reactor_task *> head_{nullptr};
+  std::atomic<bool> signalled_{false};
+};
+
+}  // namespace pposix::lnx
@@ -0,0 +1,36 @@
+#pragma once
+
+#include <system_error>
+
+#include "pposix/result.hpp"
+#include "pposix/socket.hpp"
+
+namespace pposix::lnx {
+
+// Corks a TCP socket while a batch of writes is made, so that a response written in several
+// pieces leaves in as few segments as possible, then uncorks it to push out the final partial
+// segment immediately. Combine it with socket_tcp_nodelay so nothing is held back outside batches.
+class tcp_cork_batch {
+ public:
+  // Cork the socket. It must outlive the batch.
+  static result<tcp_cork_batch> create(socket &s) noexcept;
+
+  tcp_cork_batch(const tcp_cork_batch &) = delete;
+  tcp_cork_batch(tcp_cork_batch &&other) noexcept;
+
+  tcp_cork_batch &operator=(const tcp_cork_batch &) = delete;
+  tcp_cork_batch &operator=(tcp_cork_batch &&other) noexcept;
+
+  // Uncorks the socket if uncork() was not called, ignoring any error.
+  ~tcp_cork_batch();
+
+  // End the batch and flush what was written.
+  std::error_code uncork() noexcept;
+
+ private:
+  explicit tcp_cork_batch(socket &s) noexcept;
+
+  socket *socket_;
+};
+
+}  // namespace pposix::lnx
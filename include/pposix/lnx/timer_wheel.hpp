@@ -0,0 +1,96 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <system_error>
+
+#include "pposix/duration.hpp"
+#include "pposix/file_descriptor.hpp"
+#include "pposix/lnx/reactor.hpp"
+#include "pposix/result.hpp"
+
+namespace pposix::lnx {
+
+namespace detail {
+
+class timer_wheel_state;
+
+}  // namespace detail
+
+// A timer scheduled on a timer_wheel. Timers are intrusive: scheduling and cancelling only relink
+// the timer, so neither allocates nor makes a system call. Destroying a scheduled timer cancels
+// it.
+class timer {
+ public:
+  timer() noexcept = default;
+
+  timer(const timer &) = delete;
+  timer(timer &&) = delete;
+
+  timer &operator=(const timer &) = delete;
+  timer &operator=(timer &&) = delete;
+
+  virtual ~timer();
+
+  virtual void on_expire() noexcept = 0;
+
+  bool scheduled() const noexcept { return wheel_ != nullptr; }
+
+ private:
+  friend class detail::timer_wheel_state;
+
+  timer *next_{nullptr};
+  timer **pprev_{nullptr};
+  uint64_t expiry_{};
+  detail::timer_wheel_state *wheel_{nullptr};
+};
+
+// A hierarchical timing wheel driven by a single periodic timerfd. Insert and cancel are O(1);
+// expiring advances the wheel one tick per timerfd expiration and cascades timers from the coarser
+// levels as the finer ones wrap. The timerfd only runs while timers are scheduled.
+class timer_wheel {
+ public:
+  timer_wheel() noexcept;
+  ~timer_wheel();
+
+  timer_wheel(const timer_wheel &) = delete;
+  timer_wheel(timer_wheel &&) noexcept;
+
+  timer_wheel &operator=(const timer_wheel &) = delete;
+  timer_wheel &operator=(timer_wheel &&) noexcept;
+
+  // Create a wheel with the given tick resolution. Delays are rounded up to whole ticks.
+  static result<timer_wheel> create(nanoseconds tick) noexcept;
+
+  // Schedule the timer to expire after delay, rescheduling it if it is already scheduled. Fails
+  // with invalid_argument on a default-constructed (or moved-from) wheel.
+  std::error_code schedule(timer &t, nanoseconds delay) noexcept;
+
+  // Cancel the timer if it is scheduled on this wheel. Fails with invalid_argument on a
+  // default-constructed (or moved-from) wheel.
+  std::error_code cancel(timer &t) noexcept;
+
+  bool empty() const noexcept { return state_ == nullptr; }
+
+  std::size_t size() const noexcept;
+
+  nanoseconds tick() const noexcept;
+
+  // The timerfd driving the wheel. Register it for epoll_read_available and call expire() when it
+  // is readable, or use attach() to let a reactor do both.
+  raw_fd fd() const noexcept;
+
+  // Read the timerfd and run every timer that has expired. Returns the number of timers run.
+  result<std::size_t> expire() noexcept;
+
+  std::error_code attach(reactor &r) noexcept;
+
+ private:
+  explicit timer_wheel(std::unique_ptr<detail::timer_wheel_state> state) noexcept;
+
+  // Heap allocated so scheduled timers can keep pointing at it when the wheel is moved.
+  std::unique_ptr<detail::timer_wheel_state> state_{};
+};
+
+}  // namespace pposix::lnx
@@ -0,0 +1,74 @@
+#pragma once
+
+#include <sys/timerfd.h>
+#include <time.h>
+
+#include <cstdint>
+#include <system_error>
+
+#include "pposix/duration.hpp"
+#include "pposix/file_descriptor.hpp"
+#include "pposix/result.hpp"
+#include "pposix/util.hpp"
+
+namespace pposix::lnx {
+
+namespace capi {
+
+enum class timerfd_clock : int {
+  realtime = CLOCK_REALTIME,
+  monotonic = CLOCK_MONOTONIC,
+  boottime = CLOCK_BOOTTIME,
+};
+
+enum class timerfd_flag : int { none = 0, cloexec = TFD_CLOEXEC, nonblock = TFD_NONBLOCK };
+
+}  // namespace capi
+
+template <capi::timerfd_flag Flag>
+using timerfd_flag = enum_flag<capi::timerfd_flag, Flag>;
+
+inline constexpr timerfd_flag<capi::timerfd_flag::none> timerfd_default{};
+inline constexpr timerfd_flag<capi::timerfd_flag::cloexec> timerfd_cloexec{};
+inline constexpr timerfd_flag<capi::timerfd_flag::nonblock> timerfd_nonblock{};
+
+class timerfd {
+ public:
+  timerfd() noexcept = default;
+
+  explicit timerfd(raw_fd fd) noexcept;
+
+  timerfd(const timerfd &) = delete;
+  timerfd(timerfd &&) noexcept = default;
+
+  timerfd &operator=(const timerfd &) = delete;
+  timerfd &operator=(timerfd &&) noexcept = default;
+
+  static result<timerfd> unsafe_create(capi::timerfd_clock clock,
+                                       capi::timerfd_flag flags) noexcept;
+
+  template <capi::timerfd_flag Flags>
+  static result<timerfd> create(const capi::timerfd_clock clock, timerfd_flag<Flags>) noexcept {
+    return unsafe_create(clock, Flags);
+  }
+
+  raw_fd fd() const noexcept { return *fd_; }
+
+  // Arm the timer to first expire after initial and then every interval. A zero interval makes it
+  // a one shot timer.
+  std::error_code set(nanoseconds initial, nanoseconds interval) noexcept;
+
+  std::error_code disarm() noexcept;
+
+  // Time left until the next expiration, or zero if the timer is disarmed.
+  result<nanoseconds> remaining() const noexcept;
+
+  // Number of expirations since the last read. Fails with resource_unavailable_try_again on a
+  // non-blocking timerfd that has not expired.
+  result<uint64_t> read() noexcept;
+
+ private:
+  file_descriptor fd_{};
+};
+
+}  // namespace pposix::lnx
@@ -0,0 +1,79 @@
+#pragma once
+
+#include <time.h>
+
+// Uses struct timespec without including <time.h> itself.
+#include <linux/errqueue.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <system_error>
+
+#include "pposix/cmsg.hpp"
+#include "pposix/result.hpp"
+#include "pposix/socket.hpp"
+#include "pposix/span.hpp"
+#include "pposix/time.hpp"
+
+namespace pposix::lnx {
+
+// Control buffer space for the timestamps of one received packet. Declare receive control buffers
+// as `alignas(::cmsghdr) std::byte control[timestamp_control_space]`.
+inline constexpr std::size_t timestamp_control_space{cmsg_space(sizeof(::scm_timestamping)) +
+                                                     cmsg_space(sizeof(::timespec))};
+
+// Kernel receive timestamps of one packet. Software stamps are taken on CLOCK_REALTIME when the
+// packet enters the network stack; hardware stamps come from the NIC's clock.
+struct packet_timestamps {
+  std::optional<pposix::timespec> software{};
+  std::optional<pposix::timespec> hardware{};
+};
+
+// Find the timestamps in the control data of a received message, enabled with
+// socket_timestampns or socket_timestamping.
+packet_timestamps rx_timestamps(cmsg_range control) noexcept;
+
+// The point in the transmit path a transmit timestamp was taken at.
+enum class tx_timestamp_type : uint32_t {
+  // The packet entered the packet scheduler (socket_timestamping::tx_sched).
+  sched = SCM_TSTAMP_SCHED,
+  // The packet was handed to the device, or sent by it for hardware stamps.
+  sent = SCM_TSTAMP_SND,
+  // All of the data was acknowledged by the peer (socket_timestamping::tx_ack).
+  acked = SCM_TSTAMP_ACK,
+};
+
+struct tx_timestamp {
+  tx_timestamp_type type{tx_timestamp_type::sent};
+
+  // With socket_timestamping::opt_id, the number of the send (datagram sockets) or of the last
+  // byte of it (stream sockets), counted from when the option was enabled.
+  uint32_t id{};
+
+  pposix::timespec time{};
+  bool hardware{false};
+};
+
+// Error queue messages read_tx_timestamps consumed that were not transmit timestamps.
+struct tx_timestamp_skipped {
+  uint64_t count{};
+
+  // The error reported by the most recent of them that carried one (an ICMP error or a local one
+  // such as EMSGSIZE), or empty.
+  std::error_code last_error{};
+};
+
+// Read transmit timestamps from the socket's error queue without blocking. Returns the number
+// stored in timestamps, zero if there are none, and adds any other messages it read to skipped.
+// Enable socket_timestamping::opt_tsonly so the kernel does not queue a copy of every sent packet
+// along with its stamp. The error queue is charged to the receive buffer and stamps that do not
+// fit are dropped, so read it regularly; the socket reports epoll_fd_error
+// (reactor_handler::on_error) when stamps are queued.
+//
+// The error queue also carries zero copy completions, which this consumes and skips: don't
+// combine transmit timestamps with zerocopy_sender on the same socket.
+result<std::size_t> read_tx_timestamps(socket &s, span<tx_timestamp> timestamps,
+                                       tx_timestamp_skipped &skipped) noexcept;
+
+}  // namespace pposix::lnx
@@ -0,0 +1,99 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+
+#include "pposix/byte_span.hpp"
+#include "pposix/cmsg.hpp"
+#include "pposix/result.hpp"
+#include "pposix/socket.hpp"
+#include "pposix/span.hpp"
+
+namespace pposix::lnx {
+
+// Send the buffers as consecutive datagrams of segment_size bytes (the last one may be shorter),
+// leaving the segmentation to the kernel or the NIC. The segment size is passed per call as a
+// UDP_SEGMENT control message, overriding socket_udp_segment.
+result<ssize_t> send_segmented(socket &s, cspan<byte_cspan> buffers, uint16_t segment_size,
+                               message_flag flags) noexcept;
+
+// The datagrams in a buffer filled by a UDP GRO receive, as views into that buffer.
+class udp_segments {
+ public:
+  class iterator {
+   public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = byte_cspan;
+    using difference_type = std::ptrdiff_t;
+    using pointer = void;
+    using reference = byte_cspan;
+
+    constexpr iterator() noexcept = default;
+
+    constexpr byte_cspan operator*() const noexcept {
+      const std::size_t left{remaining_.length()};
+      return remaining_.subspan(0u, left < segment_size_ ? left : segment_size_);
+    }
+
+    constexpr iterator &operator++() noexcept {
+      const std::size_t left{remaining_.length()};
+      remaining_ = left <= segment_size_ ? byte_cspan{}
+                                         : remaining_.subspan(segment_size_, left - segment_size_);
+      return *this;
+    }
+
+    constexpr iterator operator++(int) noexcept {
+      iterator previous{*this};
+      ++*this;
+      return previous;
+    }
+
+    constexpr bool operator==(const iterator &other) const noexcept {
+      return remaining_.data() == other.remaining_.data();
+    }
+
+    constexpr bool operator!=(const iterator &other) const noexcept { return not(*this == other); }
+
+   private:
+    friend class udp_segments;
+
+    constexpr iterator(const byte_cspan remaining, const std::size_t segment_size) noexcept
+        : remaining_{remaining}, segment_size_{segment_size} {}
+
+    byte_cspan remaining_{};
+    std::size_t segment_size_{};
+  };
+
+  constexpr udp_segments() noexcept = default;
+
+  // A segment size of zero means the data is a single datagram.
+  constexpr udp_segments(const byte_cspan data, const std::size_t segment_size) noexcept
+      : data_{data}, segment_size_{segment_size == 0u ? data.length() : segment_size} {}
+
+  constexpr byte_cspan data() const noexcept { return data_; }
+
+  constexpr std::size_t segment_size() const noexcept { return segment_size_; }
+
+  constexpr std::size_t size() const noexcept {
+    return data_.empty() ? 0u : (data_.length() + segment_size_ - 1u) / segment_size_;
+  }
+
+  constexpr iterator begin() const noexcept {
+    return data_.empty() ? iterator{} : iterator{data_, segment_size_};
+  }
+  constexpr iterator end() const noexcept { return {}; }
+
+ private:
+  byte_cspan data_{};
+  std::size_t segment_size_{};
+};
+
+// Split the received bytes using the UDP_GRO control message among control, if there is one.
+udp_segments gro_segments(byte_cspan data, cmsg_range control) noexcept;
+
+// Receive into buffer, which with socket_udp_gro enabled may hold several coalesced datagrams, and
+// return them as views into buffer. Size buffer for the largest coalesced receive (up to 64 KiB).
+result<udp_segments> recv_coalesced(socket &s, byte_span buffer, message_flag flags) noexcept;
+
+}  // namespace pposix::lnx
@@ -0,0 +1,244 @@
+#pragma once
+
+#include <linux/if_xdp.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <system_error>
+#include <utility>
+
+#include "pposix/byte_span.hpp"
+#include "pposix/file_descriptor.hpp"
+#include "pposix/mman.hpp"
+#include "pposix/result.hpp"
+#include "pposix/socket.hpp"
+#include "pposix/util.hpp"
+
+namespace pposix::lnx {
+
+class xdp_socket;
+
+namespace detail {
+
+// One ring shared with the kernel. The producer and consumer indices run freely and are masked
+// into the descriptor array; each side keeps a cached copy of the other's index so it only touches
+// the shared cache line when the cached view runs out.
+template <class Desc>
+class xdp_ring {
+ public:
+  xdp_ring() noexcept = default;
+
+  xdp_ring(const xdp_ring &) = delete;
+  xdp_ring(xdp_ring &&) noexcept = default;
+
+  xdp_ring &operator=(const xdp_ring &) = delete;
+  xdp_ring &operator=(xdp_ring &&) noexcept = default;
+
+  // The descriptor at an index returned by reserve or peek.
+  Desc &operator[](const uint32_t index) noexcept { return descs_[index & mask_]; }
+  const Desc &operator[](const uint32_t index) const noexcept { return descs_[index & mask_]; }
+
+  uint32_t size() const noexcept { return size_; }
+
+  // The kernel only processes this ring when woken up, see xdp_bind_flag::need_wakeup.
+  bool needs_wakeup() const noexcept {
+    return (__atomic_load_n(flags_, __ATOMIC_RELAXED) & XDP_RING_NEED_WAKEUP) != 0u;
+  }
+
+ protected:
+  friend class lnx::xdp_socket;
+
+  xdp_ring(mmap map, const ::xdp_ring_offset &offsets, const uint32_t size) noexcept
+      : map_{std::move(map)}, size_{size}, mask_{size - 1u} {
+    std::byte *const base{map_.bytes().data()};
+    producer_ = reinterpret_cast<uint32_t *>(base + offsets.producer);
+    consumer_ = reinterpret_cast<uint32_t *>(base + offsets.consumer);
+    flags_ = reinterpret_cast<uint32_t *>(base + offsets.flags);
+    descs_ = reinterpret_cast<Desc *>(base + offsets.desc);
+  }
+
+  static uint32_t load(const uint32_t *index) noexcept {
+    return __atomic_load_n(index, __ATOMIC_ACQUIRE);
+  }
+
+  // Only one side writes each index, so a plain read of our own index is enough.
+  static void advance(uint32_t *index, const uint32_t count) noexcept {
+    __atomic_store_n(index, *index + count, __ATOMIC_RELEASE);
+  }
+
+  mmap map_{};
+  uint32_t *producer_{nullptr};
+  uint32_t *consumer_{nullptr};
+  uint32_t *flags_{nullptr};
+  Desc *descs_{nullptr};
+  uint32_t size_{0u};
+  uint32_t mask_{0u};
+  uint32_t cached_producer_{0u};
+  uint32_t cached_consumer_{0u};
+};
+
+}  // namespace detail
+
+// The process side produces into this ring: the fill ring (UMEM addresses the kernel may receive
+// into) and the TX ring (frames to send).
+template <class Desc>
+class xdp_producer_ring : public detail::xdp_ring<Desc> {
+ public:
+  using detail::xdp_ring<Desc>::xdp_ring;
+
+  // Reserve up to count descriptors starting at index. Returns how many were reserved; fill them
+  // in and submit them in order.
+  uint32_t reserve(uint32_t count, uint32_t &index) noexcept {
+    uint32_t free{this->size_ - (this->cached_producer_ - this->cached_consumer_)};
+    if (free < count) {
+      this->cached_consumer_ = this->load(this->consumer_);
+      free = this->size_ - (this->cached_producer_ - this->cached_consumer_);
+    }
+
+    count = std::min(count, free);
+    index = this->cached_producer_;
+    this->cached_producer_ += count;
+    return count;
+  }
+
+  // Hand the next count reserved descriptors to the kernel.
+  void submit(const uint32_t count) noexcept { this->advance(this->producer_, count); }
+};
+
+// The kernel produces into this ring: the completion ring (UMEM addresses it has finished sending)
+// and the RX ring (received frames).
+template <class Desc>
+class xdp_consumer_ring : public detail::xdp_ring<Desc> {
+ public:
+  using detail::xdp_ring<Desc>::xdp_ring;
+
+  // Take up to count ready descriptors starting at index. Returns how many were taken; release
+  // them in order once done with them.
+  uint32_t peek(uint32_t count, uint32_t &index) noexcept {
+    uint32_t available{this->cached_producer_ - this->cached_consumer_};
+    if (available < count) {
+      this->cached_producer_ = this->load(this->producer_);
+      available = this->cached_producer_ - this->cached_consumer_;
+    }
+
+    count = std::min(count, available);
+    index = this->cached_consumer_;
+    this->cached_consumer_ += count;
+    return count;
+  }
+
+  // Give the next count peeked descriptors back to the kernel.
+  void release(const uint32_t count) noexcept { this->advance(this->consumer_, count); }
+};
+
+using xdp_fill_ring = xdp_producer_ring<uint64_t>;
+using xdp_completion_ring = xdp_consumer_ring<uint64_t>;
+using xdp_rx_ring = xdp_consumer_ring<::xdp_desc>;
+using xdp_tx_ring = xdp_producer_ring<::xdp_desc>;
+
+enum class xdp_bind_flag : uint16_t {
+  none = 0,
+  // Copy frames between the driver and the UMEM. This is the only mode available with generic
+  // (SKB) XDP, e.g. on veth without native support.
+  copy = XDP_COPY,
+  zerocopy = XDP_ZEROCOPY,
+  // The kernel sets XDP_RING_NEED_WAKEUP on the fill and TX rings when it needs wake_rx or
+  // wake_tx to make progress, instead of always needing them.
+  need_wakeup = XDP_USE_NEED_WAKEUP,
+};
+
+constexpr xdp_bind_flag operator|(const xdp_bind_flag lhs, const xdp_bind_flag rhs) noexcept {
+  return xdp_bind_flag{static_cast<uint16_t>(underlying_v(lhs) | underlying_v(rhs))};
+}
+
+struct xdp_socket_config {
+  // The UMEM is frame_count frames of frame_size bytes each. frame_size is a power of two between
+  // 2048 and the page size; the kernel places received data frame_headroom bytes into a frame.
+  uint32_t frame_count{4096u};
+  uint32_t frame_size{4096u};
+  uint32_t frame_headroom{0u};
+
+  // Ring sizes are powers of two. Either of rx_size and tx_size can be zero for a socket that
+  // only sends or only receives.
+  uint32_t fill_size{2048u};
+  uint32_t completion_size{2048u};
+  uint32_t rx_size{2048u};
+  uint32_t tx_size{2048u};
+};
+
+struct xdp_socket_stats {
+  uint64_t rx_dropped{};
+  uint64_t rx_invalid_descs{};
+  uint64_t tx_invalid_descs{};
+  uint64_t rx_ring_full{};
+  uint64_t rx_fill_ring_empty_descs{};
+  uint64_t tx_ring_empty_descs{};
+};
+
+// An AF_XDP socket with its own UMEM: an anonymous mapping divided into frames that the kernel
+// receives into and sends from, and the four rings that pass frame addresses back and forth.
+// Requires CAP_NET_RAW.
+//
+// To send, reserve TX descriptors pointing at frames, submit them and call wake_tx; finished
+// frames come back on the completion ring. To receive, keep the fill ring stocked with free frames
+// and peek the RX ring. Frames only reach the RX ring through an XDP program on the interface that
+// redirects into an XSKMAP holding fd(); loading one is outside the scope of pposix. fd() can be
+// registered with epoll or a reactor to wait for RX.
+class xdp_socket {
+ public:
+  xdp_socket() noexcept = default;
+
+  xdp_socket(const xdp_socket &) = delete;
+  xdp_socket(xdp_socket &&) noexcept = default;
+
+  xdp_socket &operator=(const xdp_socket &) = delete;
+  xdp_socket &operator=(xdp_socket &&) noexcept = default;
+
+  static result<xdp_socket> create(const xdp_socket_config &config, socket_flag flags) noexcept;
+
+  // Attach to one queue of an interface (e.g. if_nametoindex("veth0") and queue 0).
+  std::error_code bind(unsigned interface_index, uint32_t queue_id, xdp_bind_flag flags) noexcept;
+
+  raw_fd fd() const noexcept { return raw_fd{static_cast<raw_fd_t>(socket_.fd())}; }
+
+  byte_span umem() noexcept { return umem_.bytes(); }
+
+  // The bytes at a UMEM address, as found in the descriptors.
+  std::byte *data(const uint64_t address) noexcept { return umem_.bytes().data() + address; }
+
+  uint32_t frame_size() const noexcept { return frame_size_; }
+  uint32_t frame_count() const noexcept { return frame_count_; }
+
+  xdp_fill_ring &fill() noexcept { return fill_; }
+  xdp_completion_ring &completion() noexcept { return completion_; }
+  xdp_rx_ring &rx() noexcept { return rx_; }
+  xdp_tx_ring &tx() noexcept { return tx_; }
+
+  // Kick the kernel into sending what was submitted to the TX ring. In copy mode each kick only
+  // sends a small batch, so keep kicking while frames are outstanding. A busy or full device is
+  // not an error; the frames go out on a later kick.
+  std::error_code wake_tx() noexcept;
+
+  // Kick the kernel into receiving after the fill ring ran dry.
+  std::error_code wake_rx() noexcept;
+
+  result<xdp_socket_stats> stats() noexcept;
+
+ private:
+  xdp_socket(mmap umem, socket s, const xdp_socket_config &config) noexcept;
+
+  // Destroyed in reverse: the rings are unmapped before the socket is closed and the UMEM is only
+  // unmapped after that.
+  mmap umem_{};
+  socket socket_{};
+  uint32_t frame_size_{0u};
+  uint32_t frame_count_{0u};
+
+  xdp_fill_ring fill_{};
+  xdp_completion_ring completion_{};
+  xdp_rx_ring rx_{};
+  xdp_tx_ring tx_{};
+};
+
+}  // namespace pposix::lnx
@@ -0,0 +1,92 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <system_error>
+
+#include "pposix/byte_span.hpp"
+#include "pposix/result.hpp"
+#include "pposix/socket.hpp"
+#include "pposix/span.hpp"
+
+namespace pposix::lnx {
+
+// A range of zero copy sends, identified by the ids returned from zerocopy_sender::send, that the
+// kernel no longer references. Their buffers may be reused.
+class zerocopy_completion {
+ public:
+  constexpr zerocopy_completion() noexcept = default;
+
+  constexpr zerocopy_completion(uint32_t first, uint32_t last, bool copied) noexcept
+      : first_{first}, last_{last}, copied_{copied} {}
+
+  constexpr uint32_t first() const noexcept { return first_; }
+  constexpr uint32_t last() const noexcept { return last_; }
+
+  // The kernel fell back to copying the data, so zero copy gained nothing for these sends. If this
+  // keeps happening (e.g. on loopback) plain sends are cheaper.
+  constexpr bool copied() const noexcept { return copied_; }
+
+  // Ids wrap around, so the range may too.
+  constexpr bool contains(const uint32_t id) const noexcept {
+    return id - first_ <= last_ - first_;
+  }
+
+  constexpr uint32_t count() const noexcept { return last_ - first_ + 1u; }
+
+ private:
+  uint32_t first_{};
+  uint32_t last_{};
+  bool copied_{false};
+};
+
+// What a zero copy send returned: the bytes queued and the id that its completion will report.
+struct zerocopy_send {
+  std::size_t bytes{};
+  uint32_t id{};
+};
+
+// Sends with MSG_ZEROCOPY on a stream or datagram socket and tracks when the kernel releases the
+// pinned buffers. Completions arrive on the socket's error queue, which epoll reports as
+// epoll_fd_error (reactor_handler::on_error); call reap() then. The socket must outlive the
+// sender.
+//
+// The error queue is shared with everything else the kernel reports there, so reap() consumes
+// those messages too. Transmit timestamps (read_tx_timestamps) conflict with zero copy on the
+// same socket: whichever reads the queue first destroys the other's messages.
+class zerocopy_sender {
+ public:
+  // Enable SO_ZEROCOPY on the socket.
+  static result<zerocopy_sender> create(socket &s) noexcept;
+
+  // Send the buffers without copying them. They must not be modified until a completion covering
+  // the returned id has been reaped. A send that fails consumes no id.
+  result<zerocopy_send> send(cspan<byte_cspan> buffers, message_flag flags) noexcept;
+
+  // Read pending completions from the error queue without blocking. Returns the number stored in
+  // completions, zero if there are none. Other messages read from the queue are counted in
+  // skipped().
+  result<std::size_t> reap(span<zerocopy_completion> completions) noexcept;
+
+  // Number of sends whose completion has not been reaped yet.
+  uint32_t pending() const noexcept { return next_id_ - completed_; }
+
+  // Error queue messages reap() read that were not completions, e.g. transmit timestamps or ICMP
+  // errors.
+  uint64_t skipped() const noexcept { return skipped_; }
+
+  // The error reported by the most recent skipped message that carried one (an ICMP error or a
+  // local one such as EMSGSIZE), or empty.
+  std::error_code last_error() const noexcept { return last_error_; }
+
+ private:
+  explicit zerocopy_sender(socket &s) noexcept;
+
+  socket *socket_;
+  uint32_t next_id_{0u};
+  uint32_t completed_{0u};
+  uint64_t skipped_{0u};
+  std::error_code last_error_{};
+};
+
+}  // namespace pposix::lnx
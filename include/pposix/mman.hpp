@@ -4,10 +4,14 @@
 
 #include <cstddef>
 #include <system_error>
+#include <type_traits>
 
+#include "pposix/byte_span.hpp"
 #include "pposix/descriptor.hpp"
+#include "pposix/extension.hpp"
 #include "pposix/file_descriptor.hpp"
 #include "pposix/result.hpp"
+#include "pposix/span.hpp"
 #include "pposix/util.hpp"
 
 namespace pposix {
@@ -27,7 +31,7 @@ class mmap_d {
   size_t length_{0u};
 };
 
-bool operator==(const mmap_d &lhs, const mmap_d &rhs) noexcept {
+inline bool operator==(const mmap_d &lhs, const mmap_d &rhs) noexcept {
   return lhs.address() == rhs.address() and lhs.length() == rhs.length();
 }
 
@@ -45,6 +49,27 @@ struct mmap_default_close_policy {
 
 }  // namespace detail
 
+// Access pattern hints for madvise.
+enum class mmap_advice : int {
+  normal = MADV_NORMAL,
+  // Read ahead aggressively and drop pages soon after they are read.
+  sequential = MADV_SEQUENTIAL,
+  // Disable read ahead.
+  random = MADV_RANDOM,
+  // Start reading the range in now.
+  willneed = MADV_WILLNEED,
+  // Drop the range from the page tables. Shared file mappings read it back from the file; private
+  // anonymous mappings read back zeros.
+  dontneed = MADV_DONTNEED,
+
+#if PPOSIX_LINUX_EXTENSION_ENABLED
+  // Back the range with transparent huge pages where possible.
+  hugepage = MADV_HUGEPAGE,
+  // Fault the whole range in now, reading it from the file, so later accesses do not fault.
+  populate_read = MADV_POPULATE_READ,
+#endif
+};
+
 namespace capi {
 
 enum class mmap_protection : int {
@@ -54,12 +79,19 @@ enum class mmap_protection : int {
   none = PROT_NONE
 };
 
-enum class mmap_flag : int { fixed = MAP_FIXED, private_ = MAP_PRIVATE, shared = MAP_SHARED };
+enum class mmap_flag : int {
+  fixed = MAP_FIXED,
+  private_ = MAP_PRIVATE,
+  shared = MAP_SHARED,
+  anonymous = MAP_ANONYMOUS
+};
 
 result<mmap_d> mmap_map(void *addr, size_t len, capi::mmap_protection prot, capi::mmap_flag flags,
                         raw_fd fildes, off_t off) noexcept;
 
-std::error_code mmap_protect(capi::mmap_protection prot) noexcept;
+std::error_code mmap_protect(mmap_d descriptor, capi::mmap_protection prot) noexcept;
+
+std::error_code mmap_advise(mmap_d descriptor, mmap_advice advice) noexcept;
 
 }  // namespace capi
 
@@ -77,6 +109,7 @@ inline constexpr mmap_protection<capi::mmap_protection::exec> mmap_execute{};
 inline constexpr mmap_flag<capi::mmap_flag::fixed> mmap_fixed{};
 inline constexpr mmap_flag<capi::mmap_flag::private_> mmap_private{};
 inline constexpr mmap_flag<capi::mmap_flag::shared> mmap_shared{};
+inline constexpr mmap_flag<capi::mmap_flag::anonymous> mmap_anonymous{};
 
 std::error_code close_mmap(const mmap_d &) noexcept;
 
@@ -110,11 +143,43 @@ class mmap {
                   "You can only specify one of 'mmap_private' or 'mmap_shared' , not both.");
 
     return result_map<mmap>(capi::mmap_map(addr, len, ProtectionFlags, Flags, fildes, off),
-                            [](const mmap_d d) { return mmap{d}; });
+                            [](const mmap_d d) noexcept { return mmap{d}; });
   }
 
   std::error_code unmap() noexcept;
 
+  constexpr bool empty() const noexcept { return mmap_d_.empty(); }
+
+  // Null when empty, rather than the MAP_FAILED an empty descriptor holds.
+  void *data() noexcept { return empty() ? nullptr : mmap_d_->address(); }
+  const void *data() const noexcept { return empty() ? nullptr : mmap_d_->address(); }
+
+  std::size_t length() const noexcept { return mmap_d_->length(); }
+
+  // The mapped bytes. Accessing them is only valid as far as the mapping's protection allows.
+  byte_span bytes() noexcept { return {static_cast<std::byte *>(data()), length()}; }
+  byte_cspan bytes() const noexcept {
+    return {static_cast<const std::byte *>(data()), length()};
+  }
+
+  // The mapping as an array of T, ignoring any trailing bytes that do not make up a whole T.
+  template <class T>
+  span<T> as() noexcept {
+    static_assert(std::is_trivially_copyable_v<T>, "Mappings can only be viewed as trivial types");
+    return {static_cast<T *>(data()), length() / sizeof(T)};
+  }
+
+  template <class T>
+  cspan<T> as() const noexcept {
+    static_assert(std::is_trivially_copyable_v<T>, "Mappings can only be viewed as trivial types");
+    return {static_cast<const T *>(data()), length() / sizeof(T)};
+  }
+
+  std::error_code advise(mmap_advice advice) noexcept;
+
+  // Advise on part of the mapping. The range is widened to whole pages and clipped to the mapping.
+  std::error_code advise(mmap_advice advice, std::size_t offset, std::size_t length) noexcept;
+
   template <capi::mmap_protection ProtectionFlags>
   std::error_code protect(mmap_protection<ProtectionFlags>) noexcept {
     static_assert(
@@ -124,7 +189,7 @@ class mmap {
              mmap_protection<ProtectionFlags>::has(mmap_execute))),
         "'mmap_no_access' cannot be set with 'mmap_read', 'mmap_write' or 'mmap_execute'.");
 
-    return capi::mmap_protect(ProtectionFlags);
+    return capi::mmap_protect(*mmap_d_, ProtectionFlags);
   }
 
  private:
@@ -83,8 +83,8 @@ class result {
   const T &operator*() const noexcept { return *detail::result_get_value_unsafe(*this); }
   T &operator*() noexcept { return *detail::result_get_value_unsafe(*this); }
 
-  const T *operator->() const noexcept { return *detail::result_get_value_unsafe(*this); }
-  T *operator->() noexcept { return *detail::result_get_value_unsafe(*this); }
+  const T *operator->() const noexcept { return detail::result_get_value_unsafe(*this); }
+  T *operator->() noexcept { return detail::result_get_value_unsafe(*this); }
 
   // Friends
   template <class U>
@@ -3,21 +3,14 @@
 #include <signal.h>
 #include <sys/signal.h>
 
+#include <system_error>
+
 #include "pposix/platform.hpp"
+#include "pposix/result.hpp"
 #include "pposix/util.hpp"
 
 namespace pposix {
 
-class sigset {
- public:
-  sigset() noexcept = default;
-
-  [[nodiscard]] inline const ::sigset_t* sigset_ptr() const noexcept { return &signals_; };
-
- private:
-  ::sigset_t signals_{};
-};
-
 #if !PPOSIX_PLATFORM_OPENBSD
 enum class sig_notify : int { none = SIGEV_NONE, signal = SIGEV_SIGNAL, thread = SIGEV_THREAD };
 #endif
@@ -49,6 +42,37 @@ enum class sig_number : int {
   file_size_limit_exceeded = SIGXFSZ
 };
 
+class sigset {
+ public:
+  sigset() noexcept;
+
+  // A set containing every signal.
+  static sigset filled() noexcept;
+
+  std::error_code add(sig_number number) noexcept;
+  std::error_code remove(sig_number number) noexcept;
+
+  std::error_code fill() noexcept;
+  std::error_code clear() noexcept;
+
+  [[nodiscard]] bool contains(sig_number number) const noexcept;
+
+  [[nodiscard]] inline ::sigset_t* sigset_ptr() noexcept { return &signals_; };
+  [[nodiscard]] inline const ::sigset_t* sigset_ptr() const noexcept { return &signals_; };
+
+ private:
+  ::sigset_t signals_{};
+};
+
+enum class sigmask_how : int { block = SIG_BLOCK, unblock = SIG_UNBLOCK, set = SIG_SETMASK };
+
+// Change the signal mask of the calling process and return the previous mask. Use
+// pthread_sigmask in multi-threaded programs.
+result<sigset> sigprocmask(sigmask_how how, const sigset& signals) noexcept;
+
+// Change the signal mask of the calling thread and return the previous mask.
+result<sigset> pthread_sigmask(sigmask_how how, const sigset& signals) noexcept;
+
 using sig_event_notify_handler = void (*)(union ::sigval);
 
 #if !PPOSIX_PLATFORM_OPENBSD
@@ -1,16 +1,35 @@
 #pragma once
 
 #include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <netinet/udp.h>
 #include <sys/socket.h>
 #include <unistd.h>
 
+#include <cstdint>
+#include <limits>
+#include <utility>
+
+#include "pposix/address.hpp"
 #include "pposix/any_view.hpp"
+#include "pposix/byte_span.hpp"
+#include "pposix/cmsg.hpp"
 #include "pposix/duration.hpp"
+#include "pposix/errno.hpp"
 #include "pposix/extension.hpp"
 #include "pposix/file_descriptor.hpp"
 #include "pposix/result.hpp"
+#include "pposix/span.hpp"
+#include "pposix/uio.hpp"
 #include "pposix/util.hpp"
 
+#if PPOSIX_LINUX_EXTENSION_ENABLED
+#include <linux/filter.h>
+#include <linux/if_packet.h>
+#include <linux/if_xdp.h>
+#include <linux/net_tstamp.h>
+#endif
+
 namespace pposix {
 
 enum class socket_domain : int {
@@ -83,8 +102,53 @@ enum class socket_option : int {
   sndtimeo = SO_SNDTIMEO,
   type = SO_TYPE,
 
+  // socket_level::tcp
+  tcp_nodelay = TCP_NODELAY,
+
 #if PPOSIX_LINUX_EXTENSION_ENABLED
-      zerocpy = SO_ZEROCOPY
+  zerocpy = SO_ZEROCOPY,
+  busy_poll = SO_BUSY_POLL,
+  prefer_busy_poll = SO_PREFER_BUSY_POLL,
+  busy_poll_budget = SO_BUSY_POLL_BUDGET,
+
+  // socket_level::udp
+  udp_segment = UDP_SEGMENT,
+  udp_gro = UDP_GRO,
+
+  // socket_level::tcp
+  tcp_cork = TCP_CORK,
+  tcp_quickack = TCP_QUICKACK,
+  tcp_notsent_lowat = TCP_NOTSENT_LOWAT,
+  tcp_fastopen = TCP_FASTOPEN,
+  tcp_defer_accept = TCP_DEFER_ACCEPT,
+  tcp_user_timeout = TCP_USER_TIMEOUT,
+  tcp_keepidle = TCP_KEEPIDLE,
+  tcp_keepintvl = TCP_KEEPINTVL,
+  tcp_keepcnt = TCP_KEEPCNT,
+
+  reuseport = SO_REUSEPORT,
+  incoming_cpu = SO_INCOMING_CPU,
+  attach_reuseport_cbpf = SO_ATTACH_REUSEPORT_CBPF,
+
+  // socket_level::tcp, see socket::tcp_info
+  tcp_info = TCP_INFO,
+
+  timestampns = SO_TIMESTAMPNS,
+  timestamping = SO_TIMESTAMPING,
+
+  // socket_level::packet, see lnx::packet_ring
+  packet_version = PACKET_VERSION,
+  packet_rx_ring = PACKET_RX_RING,
+  packet_statistics = PACKET_STATISTICS,
+
+  // socket_level::xdp, see lnx::xdp_socket
+  xdp_mmap_offsets = XDP_MMAP_OFFSETS,
+  xdp_rx_ring = XDP_RX_RING,
+  xdp_tx_ring = XDP_TX_RING,
+  xdp_umem_reg = XDP_UMEM_REG,
+  xdp_umem_fill_ring = XDP_UMEM_FILL_RING,
+  xdp_umem_completion_ring = XDP_UMEM_COMPLETION_RING,
+  xdp_statistics = XDP_STATISTICS,
 #endif
 };
 
@@ -101,6 +165,37 @@ constexpr socket_flag operator|(socket_flag lhs, socket_flag rhs) noexcept {
   return socket_flag{underlying_v(lhs) | underlying_v(rhs)};
 }
 
+enum class message_flag : int {
+  none = 0,
+  dontroute = MSG_DONTROUTE,
+  eor = MSG_EOR,
+  oob = MSG_OOB,
+  nosignal = MSG_NOSIGNAL,
+  peek = MSG_PEEK,
+  waitall = MSG_WAITALL,
+
+  // Reported by recvmsg
+  trunc = MSG_TRUNC,
+  ctrunc = MSG_CTRUNC,
+
+#if PPOSIX_LINUX_EXTENSION_ENABLED
+  dontwait = MSG_DONTWAIT,
+  more = MSG_MORE,
+  errqueue = MSG_ERRQUEUE,
+  cmsg_cloexec = MSG_CMSG_CLOEXEC,
+  waitforone = MSG_WAITFORONE,
+  zerocopy = MSG_ZEROCOPY,
+#endif
+};
+
+constexpr message_flag operator|(message_flag lhs, message_flag rhs) noexcept {
+  return message_flag{underlying_v(lhs) | underlying_v(rhs)};
+}
+
+constexpr message_flag operator&(message_flag lhs, message_flag rhs) noexcept {
+  return message_flag{underlying_v(lhs) & underlying_v(rhs)};
+}
+
 enum class socket_level : int {
   socket = SOL_SOCKET,
   ip = IPPROTO_IP,
@@ -109,6 +204,11 @@ enum class socket_level : int {
   raw = IPPROTO_RAW,
   tcp = IPPROTO_TCP,
   udp = IPPROTO_UDP,
+
+#if PPOSIX_LINUX_EXTENSION_ENABLED
+  packet = SOL_PACKET,
+  xdp = SOL_XDP,
+#endif
 };
 
 using socket_fd_t = int;
@@ -211,10 +311,690 @@ class socket_sndtimeo {
   ::timeval timeout_{};
 };
 
+// TCP options (socket_level::tcp)
+
+// Send segments as soon as possible instead of coalescing small writes (Nagle's algorithm).
+enum class socket_tcp_nodelay : bool { off = false, on = true };
+
+#if PPOSIX_LINUX_EXTENSION_ENABLED
+// Only send full segments until uncorked, at most 200ms. See lnx::tcp_cork_batch.
+enum class socket_tcp_cork : bool { off = false, on = true };
+
+// Acknowledge immediately instead of delaying acks. Not permanent: the kernel may switch back.
+enum class socket_tcp_quickack : bool { off = false, on = true };
+
+// Report the socket writable only while fewer than this many bytes are queued but unsent.
+enum class socket_tcp_notsent_lowat : int {};
+
+// Accept TCP Fast Open connections on a listening socket, with this many pending at most.
+enum class socket_tcp_fastopen : int {};
+
+// Only complete accept once data has arrived, waiting at most this long.
+class socket_tcp_defer_accept {
+ public:
+  constexpr socket_tcp_defer_accept() noexcept = default;
+  constexpr explicit socket_tcp_defer_accept(pposix::seconds s) noexcept : timeout_{s.count()} {}
+
+  constexpr pposix::seconds timeout() const noexcept { return pposix::seconds{timeout_}; }
+
+ private:
+  int timeout_{};
+};
+
+// Abort the connection when sent data stays unacknowledged for this long. Zero uses the system
+// default.
+class socket_tcp_user_timeout {
+ public:
+  constexpr socket_tcp_user_timeout() noexcept = default;
+  constexpr explicit socket_tcp_user_timeout(pposix::milliseconds ms) noexcept
+      : timeout_{static_cast<unsigned>(ms.count())} {}
+
+  constexpr pposix::milliseconds timeout() const noexcept {
+    return pposix::milliseconds{static_cast<int>(timeout_)};
+  }
+
+ private:
+  unsigned timeout_{};
+};
+
+// Idle time before the first keepalive probe.
+class socket_tcp_keepidle {
+ public:
+  constexpr socket_tcp_keepidle() noexcept = default;
+  constexpr explicit socket_tcp_keepidle(pposix::seconds s) noexcept : idle_{s.count()} {}
+
+  constexpr pposix::seconds idle() const noexcept { return pposix::seconds{idle_}; }
+
+ private:
+  int idle_{};
+};
+
+// Time between keepalive probes.
+class socket_tcp_keepintvl {
+ public:
+  constexpr socket_tcp_keepintvl() noexcept = default;
+  constexpr explicit socket_tcp_keepintvl(pposix::seconds s) noexcept : interval_{s.count()} {}
+
+  constexpr pposix::seconds interval() const noexcept { return pposix::seconds{interval_}; }
+
+ private:
+  int interval_{};
+};
+
+// Unanswered keepalive probes before the connection is dropped.
+enum class socket_tcp_keepcnt : int {};
+
+// Let several sockets bind the same address and port. The kernel balances incoming connections
+// (or datagrams) across them. See lnx::reuseport_group.
+enum class socket_reuseport : bool { off = false, on = true };
+
+// The CPU the socket's traffic is processed on. Setting it is a hint for reuseport balancing.
+enum class socket_incoming_cpu : int {};
+
+// A classic BPF program that picks the socket of a reuseport group that receives each incoming
+// connection or datagram, by returning its index. Set only; the program is copied by the kernel.
+class socket_reuseport_cbpf {
+ public:
+  constexpr explicit socket_reuseport_cbpf(cspan<::sock_filter> program) noexcept
+      : program_{program} {}
+
+  constexpr cspan<::sock_filter> program() const noexcept { return program_; }
+
+ private:
+  cspan<::sock_filter> program_;
+};
+
+// Busy polling: blocking reads and polls on the socket spin on the device queue for up to this
+// many microseconds before sleeping. Raising it above net.core.busy_read requires CAP_NET_ADMIN.
+enum class socket_busy_poll : int {};
+
+// Keep busy polling the device queue even while it is under load instead of deferring to softirq
+// processing; only effective together with socket_busy_poll and napi_defer_hard_irqs.
+enum class socket_prefer_busy_poll : bool { off = false, on = true };
+
+// Allow sends with message_flag::zerocopy. See lnx::zerocopy_sender.
+enum class socket_zerocopy : bool { off = false, on = true };
+
+// Maximum number of packets processed per busy poll iteration. Raising it above the default
+// requires CAP_NET_ADMIN. The kernel does not support reading it back.
+enum class socket_busy_poll_budget : int {};
+
+// UDP generic segmentation offload (socket_level::udp): every send is split into datagrams of this
+// many bytes. Zero disables it; lnx::send_segmented sets the size per send instead.
+enum class socket_udp_segment : int {};
+
+// UDP generic receive offload (socket_level::udp): consecutive datagrams from the same flow may be
+// coalesced into one receive. See lnx::recv_coalesced.
+enum class socket_udp_gro : bool { off = false, on = true };
+
+// Attach the time each packet was received, in nanoseconds, as an SCM_TIMESTAMPNS control
+// message. See lnx::rx_timestamps.
+enum class socket_timestampns : bool { off = false, on = true };
+
+// Which timestamps the kernel generates (SOF_TIMESTAMPING_*) and how it reports them. Combine a
+// generation flag with a reporting flag, e.g. rx_software | software for receive stamps. Receive
+// stamps arrive as SCM_TIMESTAMPING control messages (lnx::rx_timestamps), transmit stamps on the
+// error queue (lnx::read_tx_timestamps).
+enum class socket_timestamping : unsigned {
+  none = 0u,
+
+  // Generation
+  tx_hardware = SOF_TIMESTAMPING_TX_HARDWARE,
+  tx_software = SOF_TIMESTAMPING_TX_SOFTWARE,
+  rx_hardware = SOF_TIMESTAMPING_RX_HARDWARE,
+  rx_software = SOF_TIMESTAMPING_RX_SOFTWARE,
+  // When the packet enters the packet scheduler, and when all of it has been acknowledged (TCP).
+  tx_sched = SOF_TIMESTAMPING_TX_SCHED,
+  tx_ack = SOF_TIMESTAMPING_TX_ACK,
+
+  // Reporting
+  software = SOF_TIMESTAMPING_SOFTWARE,
+  raw_hardware = SOF_TIMESTAMPING_RAW_HARDWARE,
+
+  // Options
+  // Number transmit stamps per send so they can be matched to it.
+  opt_id = SOF_TIMESTAMPING_OPT_ID,
+  // Report transmit stamps without a copy of the packet.
+  opt_tsonly = SOF_TIMESTAMPING_OPT_TSONLY,
+  // Also report receive stamps for packets the socket has not bound a device for.
+  opt_cmsg = SOF_TIMESTAMPING_OPT_CMSG,
+};
+
+constexpr socket_timestamping operator|(const socket_timestamping lhs,
+                                        const socket_timestamping rhs) noexcept {
+  return socket_timestamping{underlying_v(lhs) | underlying_v(rhs)};
+}
+
+constexpr socket_timestamping operator&(const socket_timestamping lhs,
+                                        const socket_timestamping rhs) noexcept {
+  return socket_timestamping{underlying_v(lhs) & underlying_v(rhs)};
+}
+#endif
+
 // Get socket option
 enum class socket_acceptconn : bool {};
 enum class socket_error : int {};
 
+// Compile-time description of each socket option type: the level it usually lives at, its name,
+// the type the kernel reads and writes and the conversions to and from that type. settable and
+// gettable are false for the options that only go one way. valid() rejects values the wire type
+// cannot represent; setsockopt fails with invalid_argument for them.
+template <class Option>
+struct socket_option_traits {
+  static_assert(always_false<Option>, "Unsupported socket option type.");
+};
+
+namespace detail {
+
+template <socket_level Level, socket_option Name, class Wire, bool Settable = true,
+          bool Gettable = true>
+struct socket_option_base {
+  using wire_type = Wire;
+
+  static constexpr socket_level level{Level};
+  static constexpr socket_option name{Name};
+  static constexpr bool settable{Settable};
+  static constexpr bool gettable{Gettable};
+
+  template <class Option>
+  static constexpr bool valid(const Option & /*option*/) noexcept {
+    return true;
+  }
+};
+
+// An on/off option, which the kernel takes as an int.
+template <class Option, socket_level Level, socket_option Name, bool Settable = true>
+struct socket_bool_option : socket_option_base<Level, Name, int, Settable> {
+  static constexpr int to_wire(const Option o) noexcept { return underlying_v(o) ? 1 : 0; }
+  static constexpr Option from_wire(const int value) noexcept { return Option{value != 0}; }
+};
+
+template <class Option, socket_level Level, socket_option Name, bool Settable = true,
+          bool Gettable = true>
+struct socket_int_option : socket_option_base<Level, Name, int, Settable, Gettable> {
+  static constexpr int to_wire(const Option o) noexcept { return underlying_v(o); }
+  static constexpr Option from_wire(const int value) noexcept { return Option{value}; }
+};
+
+// An option holding a duration, read with Get, which the kernel takes as a count of Wire.
+template <class Option, socket_level Level, socket_option Name, class Duration,
+          Duration (Option::*Get)() const noexcept, class Wire = int>
+struct socket_duration_option : socket_option_base<Level, Name, Wire> {
+  static constexpr Wire to_wire(const Option o) noexcept {
+    return static_cast<Wire>((o.*Get)().count());
+  }
+
+  static constexpr Option from_wire(const Wire value) noexcept {
+    return Option{Duration{static_cast<typename Duration::rep>(value)}};
+  }
+};
+
+template <class Option, socket_option Name>
+struct socket_timeval_option : socket_option_base<socket_level::socket, Name, ::timeval> {
+  static constexpr ::timeval to_wire(const Option o) noexcept { return o.get(); }
+
+  static constexpr Option from_wire(const ::timeval value) noexcept {
+    return Option{pposix::seconds{static_cast<int>(value.tv_sec)},
+                  pposix::microseconds{static_cast<int>(value.tv_usec)}};
+  }
+};
+
+}  // namespace detail
+
+template <>
+struct socket_option_traits<socket_debug>
+    : detail::socket_bool_option<socket_debug, socket_level::socket, socket_option::debug> {};
+
+template <>
+struct socket_option_traits<socket_broadcast>
+    : detail::socket_bool_option<socket_broadcast, socket_level::socket,
+                                 socket_option::broadcast> {};
+
+template <>
+struct socket_option_traits<socket_reuseaddr>
+    : detail::socket_bool_option<socket_reuseaddr, socket_level::socket,
+                                 socket_option::reuseaddr> {};
+
+template <>
+struct socket_option_traits<socket_keepalive>
+    : detail::socket_bool_option<socket_keepalive, socket_level::socket,
+                                 socket_option::keepalive> {};
+
+template <>
+struct socket_option_traits<socket_linger>
+    : detail::socket_option_base<socket_level::socket, socket_option::linger, ::linger> {
+  static constexpr ::linger to_wire(const socket_linger &o) noexcept { return o.get(); }
+  static constexpr socket_linger from_wire(const ::linger value) noexcept { return value; }
+};
+
+template <>
+struct socket_option_traits<socket_oobinline>
+    : detail::socket_bool_option<socket_oobinline, socket_level::socket,
+                                 socket_option::oobinline> {};
+
+template <>
+struct socket_option_traits<socket_sndbuf>
+    : detail::socket_int_option<socket_sndbuf, socket_level::socket, socket_option::sndbuf> {};
+
+template <>
+struct socket_option_traits<socket_rcvbuf>
+    : detail::socket_int_option<socket_rcvbuf, socket_level::socket, socket_option::rcvbuf> {};
+
+template <>
+struct socket_option_traits<socket_dontroute>
+    : detail::socket_bool_option<socket_dontroute, socket_level::socket,
+                                 socket_option::dontroute> {};
+
+template <>
+struct socket_option_traits<socket_rcvlowat>
+    : detail::socket_int_option<socket_rcvlowat, socket_level::socket, socket_option::rcvlowat> {};
+
+template <>
+struct socket_option_traits<socket_rcvtimeo>
+    : detail::socket_timeval_option<socket_rcvtimeo, socket_option::rcvtimeo> {};
+
+template <>
+struct socket_option_traits<socket_sndlowat>
+    : detail::socket_int_option<socket_sndlowat, socket_level::socket, socket_option::sndlowat> {};
+
+template <>
+struct socket_option_traits<socket_sndtimeo>
+    : detail::socket_timeval_option<socket_sndtimeo, socket_option::sndtimeo> {};
+
+template <>
+struct socket_option_traits<socket_acceptconn>
+    : detail::socket_bool_option<socket_acceptconn, socket_level::socket,
+                                 socket_option::acceptconn, false> {};
+
+template <>
+struct socket_option_traits<socket_error>
+    : detail::socket_int_option<socket_error, socket_level::socket, socket_option::error, false> {
+};
+
+template <>
+struct socket_option_traits<socket_type>
+    : detail::socket_int_option<socket_type, socket_level::socket, socket_option::type, false> {};
+
+template <>
+struct socket_option_traits<socket_tcp_nodelay>
+    : detail::socket_bool_option<socket_tcp_nodelay, socket_level::tcp,
+                                 socket_option::tcp_nodelay> {};
+
+#if PPOSIX_LINUX_EXTENSION_ENABLED
+template <>
+struct socket_option_traits<socket_zerocopy>
+    : detail::socket_bool_option<socket_zerocopy, socket_level::socket, socket_option::zerocpy> {};
+
+template <>
+struct socket_option_traits<socket_busy_poll>
+    : detail::socket_int_option<socket_busy_poll, socket_level::socket,
+                                socket_option::busy_poll> {};
+
+template <>
+struct socket_option_traits<socket_prefer_busy_poll>
+    : detail::socket_bool_option<socket_prefer_busy_poll, socket_level::socket,
+                                 socket_option::prefer_busy_poll> {};
+
+template <>
+struct socket_option_traits<socket_busy_poll_budget>
+    : detail::socket_int_option<socket_busy_poll_budget, socket_level::socket,
+                                socket_option::busy_poll_budget, true, false> {};
+
+template <>
+struct socket_option_traits<socket_udp_segment>
+    : detail::socket_int_option<socket_udp_segment, socket_level::udp,
+                                socket_option::udp_segment> {};
+
+template <>
+struct socket_option_traits<socket_udp_gro>
+    : detail::socket_bool_option<socket_udp_gro, socket_level::udp, socket_option::udp_gro> {};
+
+template <>
+struct socket_option_traits<socket_tcp_cork>
+    : detail::socket_bool_option<socket_tcp_cork, socket_level::tcp, socket_option::tcp_cork> {};
+
+template <>
+struct socket_option_traits<socket_tcp_quickack>
+    : detail::socket_bool_option<socket_tcp_quickack, socket_level::tcp,
+                                 socket_option::tcp_quickack> {};
+
+template <>
+struct socket_option_traits<socket_tcp_notsent_lowat>
+    : detail::socket_int_option<socket_tcp_notsent_lowat, socket_level::tcp,
+                                socket_option::tcp_notsent_lowat> {};
+
+template <>
+struct socket_option_traits<socket_tcp_fastopen>
+    : detail::socket_int_option<socket_tcp_fastopen, socket_level::tcp,
+                                socket_option::tcp_fastopen> {};
+
+template <>
+struct socket_option_traits<socket_tcp_defer_accept>
+    : detail::socket_duration_option<socket_tcp_defer_accept, socket_level::tcp,
+                                     socket_option::tcp_defer_accept, pposix::seconds,
+                                     &socket_tcp_defer_accept::timeout> {};
+
+template <>
+struct socket_option_traits<socket_tcp_user_timeout>
+    : detail::socket_duration_option<socket_tcp_user_timeout, socket_level::tcp,
+                                     socket_option::tcp_user_timeout, pposix::milliseconds,
+                                     &socket_tcp_user_timeout::timeout, unsigned> {};
+
+template <>
+struct socket_option_traits<socket_tcp_keepidle>
+    : detail::socket_duration_option<socket_tcp_keepidle, socket_level::tcp,
+                                     socket_option::tcp_keepidle, pposix::seconds,
+                                     &socket_tcp_keepidle::idle> {};
+
+template <>
+struct socket_option_traits<socket_tcp_keepintvl>
+    : detail::socket_duration_option<socket_tcp_keepintvl, socket_level::tcp,
+                                     socket_option::tcp_keepintvl, pposix::seconds,
+                                     &socket_tcp_keepintvl::interval> {};
+
+template <>
+struct socket_option_traits<socket_tcp_keepcnt>
+    : detail::socket_int_option<socket_tcp_keepcnt, socket_level::tcp,
+                                socket_option::tcp_keepcnt> {};
+
+template <>
+struct socket_option_traits<socket_reuseport>
+    : detail::socket_bool_option<socket_reuseport, socket_level::socket,
+                                 socket_option::reuseport> {};
+
+template <>
+struct socket_option_traits<socket_incoming_cpu>
+    : detail::socket_int_option<socket_incoming_cpu, socket_level::socket,
+                                socket_option::incoming_cpu> {};
+
+template <>
+struct socket_option_traits<socket_reuseport_cbpf>
+    : detail::socket_option_base<socket_level::socket, socket_option::attach_reuseport_cbpf,
+                                 ::sock_fprog, true, false> {
+  // sock_fprog counts the instructions in an unsigned short.
+  static constexpr bool valid(const socket_reuseport_cbpf &o) noexcept {
+    return o.program().length() <= std::numeric_limits<unsigned short>::max();
+  }
+
+  static ::sock_fprog to_wire(const socket_reuseport_cbpf &o) noexcept {
+    return ::sock_fprog{static_cast<unsigned short>(o.program().length()),
+                        const_cast<::sock_filter *>(o.program().data())};
+  }
+};
+
+template <>
+struct socket_option_traits<socket_timestampns>
+    : detail::socket_bool_option<socket_timestampns, socket_level::socket,
+                                 socket_option::timestampns> {};
+
+template <>
+struct socket_option_traits<socket_timestamping>
+    : detail::socket_option_base<socket_level::socket, socket_option::timestamping, int> {
+  static constexpr int to_wire(const socket_timestamping o) noexcept {
+    return static_cast<int>(underlying_v(o));
+  }
+
+  static constexpr socket_timestamping from_wire(const int value) noexcept {
+    return socket_timestamping{static_cast<unsigned>(value)};
+  }
+};
+#endif
+
+// What recvmsg received: the number of bytes written to the buffers, the message flags reported
+// by the kernel and the part of the control buffer that was filled in.
+class received_message {
+ public:
+  constexpr received_message() noexcept = default;
+
+  constexpr received_message(std::size_t bytes, message_flag flags, byte_cspan control) noexcept
+      : bytes_{bytes}, flags_{flags}, control_{control} {}
+
+  constexpr std::size_t bytes() const noexcept { return bytes_; }
+
+  constexpr message_flag flags() const noexcept { return flags_; }
+
+  // The datagram was larger than the buffers and the rest of it was discarded.
+  constexpr bool truncated() const noexcept {
+    return (flags_ & message_flag::trunc) != message_flag::none;
+  }
+
+  // Some control messages did not fit in the control buffer and were discarded.
+  constexpr bool control_truncated() const noexcept {
+    return (flags_ & message_flag::ctrunc) != message_flag::none;
+  }
+
+  cmsg_range control() const noexcept { return cmsg_range{control_}; }
+
+ private:
+  std::size_t bytes_{};
+  message_flag flags_{message_flag::none};
+  byte_cspan control_{};
+};
+
+#if PPOSIX_LINUX_EXTENSION_ENABLED
+// One message of a recv_batch or send_batch call. Layout compatible with mmsghdr, so an array of
+// them is passed to the kernel as is. The buffers, address and control buffer are referenced, not
+// copied. Receiving overwrites the address and control lengths, so set them again before reusing
+// a message for another receive.
+class batch_message : private ::mmsghdr {
+ public:
+  batch_message() noexcept : ::mmsghdr{} {}
+
+  void set_buffers(span<byte_span> buffers) noexcept {
+    msg_hdr.msg_iov = detail::as_iovec(buffers);
+    msg_hdr.msg_iovlen = buffers.length();
+  }
+
+  void set_buffers(cspan<byte_cspan> buffers) noexcept {
+    msg_hdr.msg_iov = detail::as_iovec(buffers);
+    msg_hdr.msg_iovlen = buffers.length();
+  }
+
+  // Where to store the source address of a received message.
+  void set_address(::sockaddr_storage &address) noexcept {
+    msg_hdr.msg_name = &address;
+    msg_hdr.msg_namelen = sizeof(address);
+  }
+
+  // Destination address of a message to send on an unconnected socket.
+  void set_address(const ::sockaddr *address, socklen_t length) noexcept {
+    msg_hdr.msg_name = const_cast<::sockaddr *>(address);
+    msg_hdr.msg_namelen = length;
+  }
+
+  // Control buffer to receive into, which must be aligned for cmsghdr.
+  void set_control(byte_span control) noexcept {
+    msg_hdr.msg_control = control.data();
+    msg_hdr.msg_controllen = control.length();
+  }
+
+  // Control messages to send, e.g. built with a cmsg_writer.
+  void set_control(byte_cspan control) noexcept {
+    msg_hdr.msg_control = const_cast<std::byte *>(control.data());
+    msg_hdr.msg_controllen = control.length();
+  }
+
+  // Bytes received into or sent from the buffers.
+  std::size_t bytes() const noexcept { return msg_len; }
+
+  message_flag flags() const noexcept { return message_flag{msg_hdr.msg_flags}; }
+
+  bool truncated() const noexcept { return (flags() & message_flag::trunc) != message_flag::none; }
+
+  socklen_t address_length() const noexcept { return msg_hdr.msg_namelen; }
+
+  cmsg_range control() const noexcept {
+    return cmsg_range{
+        byte_cspan{static_cast<const std::byte *>(msg_hdr.msg_control), msg_hdr.msg_controllen}};
+  }
+};
+
+static_assert(sizeof(batch_message) == sizeof(::mmsghdr));
+static_assert(alignof(batch_message) == alignof(::mmsghdr));
+
+namespace detail {
+
+// struct tcp_info as defined by <linux/tcp.h>, which cannot be included along with
+// <netinet/tcp.h>; the glibc copy stops at tcpi_total_retrans. The kernel only ever appends
+// fields and fills in as much of the structure as both sides know about.
+struct kernel_tcp_info {
+  uint8_t tcpi_state;
+  uint8_t tcpi_ca_state;
+  uint8_t tcpi_retransmits;
+  uint8_t tcpi_probes;
+  uint8_t tcpi_backoff;
+  uint8_t tcpi_options;
+  uint8_t tcpi_snd_wscale : 4, tcpi_rcv_wscale : 4;
+  uint8_t tcpi_delivery_rate_app_limited : 1, tcpi_fastopen_client_fail : 2;
+
+  uint32_t tcpi_rto;
+  uint32_t tcpi_ato;
+  uint32_t tcpi_snd_mss;
+  uint32_t tcpi_rcv_mss;
+
+  uint32_t tcpi_unacked;
+  uint32_t tcpi_sacked;
+  uint32_t tcpi_lost;
+  uint32_t tcpi_retrans;
+  uint32_t tcpi_fackets;
+
+  uint32_t tcpi_last_data_sent;
+  uint32_t tcpi_last_ack_sent;
+  uint32_t tcpi_last_data_recv;
+  uint32_t tcpi_last_ack_recv;
+
+  uint32_t tcpi_pmtu;
+  uint32_t tcpi_rcv_ssthresh;
+  uint32_t tcpi_rtt;
+  uint32_t tcpi_rttvar;
+  uint32_t tcpi_snd_ssthresh;
+  uint32_t tcpi_snd_cwnd;
+  uint32_t tcpi_advmss;
+  uint32_t tcpi_reordering;
+
+  uint32_t tcpi_rcv_rtt;
+  uint32_t tcpi_rcv_space;
+
+  uint32_t tcpi_total_retrans;
+
+  uint64_t tcpi_pacing_rate;
+  uint64_t tcpi_max_pacing_rate;
+  uint64_t tcpi_bytes_acked;
+  uint64_t tcpi_bytes_received;
+  uint32_t tcpi_segs_out;
+  uint32_t tcpi_segs_in;
+
+  uint32_t tcpi_notsent_bytes;
+  uint32_t tcpi_min_rtt;
+  uint32_t tcpi_data_segs_in;
+  uint32_t tcpi_data_segs_out;
+
+  uint64_t tcpi_delivery_rate;
+
+  uint64_t tcpi_busy_time;
+  uint64_t tcpi_rwnd_limited;
+  uint64_t tcpi_sndbuf_limited;
+
+  uint32_t tcpi_delivered;
+  uint32_t tcpi_delivered_ce;
+
+  uint64_t tcpi_bytes_sent;
+  uint64_t tcpi_bytes_retrans;
+  uint32_t tcpi_dsack_dups;
+  uint32_t tcpi_reord_seen;
+
+  uint32_t tcpi_rcv_ooopack;
+
+  uint32_t tcpi_snd_wnd;
+};
+
+static_assert(sizeof(kernel_tcp_info) == 232u);
+
+}  // namespace detail
+
+// A snapshot of the kernel's state for a TCP connection. Times are in microseconds, rates in bytes
+// per second. Fields that the running kernel is too old to report read as zero; length() says how
+// much it filled in.
+class tcp_info_snapshot {
+ public:
+  constexpr tcp_info_snapshot() noexcept = default;
+
+  static result<tcp_info_snapshot> read(socket_fd fd) noexcept;
+
+  // The TCP_* connection state, e.g. TCP_ESTABLISHED.
+  constexpr int state() const noexcept { return info_.tcpi_state; }
+
+  constexpr pposix::microseconds rtt() const noexcept { return microseconds_of(info_.tcpi_rtt); }
+
+  constexpr pposix::microseconds rtt_variance() const noexcept {
+    return microseconds_of(info_.tcpi_rttvar);
+  }
+
+  constexpr pposix::microseconds min_rtt() const noexcept {
+    return microseconds_of(info_.tcpi_min_rtt);
+  }
+
+  constexpr pposix::microseconds rto() const noexcept { return microseconds_of(info_.tcpi_rto); }
+
+  // Congestion window and slow start threshold, in segments of snd_mss() bytes.
+  constexpr uint32_t snd_cwnd() const noexcept { return info_.tcpi_snd_cwnd; }
+  constexpr uint32_t snd_ssthresh() const noexcept { return info_.tcpi_snd_ssthresh; }
+  constexpr uint32_t snd_mss() const noexcept { return info_.tcpi_snd_mss; }
+
+  // The peer's receive window in bytes.
+  constexpr uint32_t snd_wnd() const noexcept { return info_.tcpi_snd_wnd; }
+
+  // Consecutive timeouts of the segment at the head of the queue.
+  constexpr uint32_t retransmits() const noexcept { return info_.tcpi_retransmits; }
+
+  // Segments retransmitted over the life of the connection.
+  constexpr uint32_t total_retransmits() const noexcept { return info_.tcpi_total_retrans; }
+
+  // Segments in flight: sent but not acknowledged, of which lost and retransmitted.
+  constexpr uint32_t unacked() const noexcept { return info_.tcpi_unacked; }
+  constexpr uint32_t lost() const noexcept { return info_.tcpi_lost; }
+  constexpr uint32_t retransmitted() const noexcept { return info_.tcpi_retrans; }
+
+  constexpr uint64_t pacing_rate() const noexcept { return info_.tcpi_pacing_rate; }
+  constexpr uint64_t delivery_rate() const noexcept { return info_.tcpi_delivery_rate; }
+
+  constexpr uint64_t bytes_sent() const noexcept { return info_.tcpi_bytes_sent; }
+  constexpr uint64_t bytes_acked() const noexcept { return info_.tcpi_bytes_acked; }
+  constexpr uint64_t bytes_received() const noexcept { return info_.tcpi_bytes_received; }
+  constexpr uint64_t bytes_retransmitted() const noexcept { return info_.tcpi_bytes_retrans; }
+
+  // Bytes written to the socket that have not been sent yet.
+  constexpr uint32_t notsent_bytes() const noexcept { return info_.tcpi_notsent_bytes; }
+
+  // Time the connection spent limited by the peer's receive window or by the send buffer.
+  constexpr pposix::microseconds rwnd_limited() const noexcept {
+    return microseconds_of(info_.tcpi_rwnd_limited);
+  }
+
+  constexpr pposix::microseconds sndbuf_limited() const noexcept {
+    return microseconds_of(info_.tcpi_sndbuf_limited);
+  }
+
+  constexpr std::size_t length() const noexcept { return length_; }
+
+  const detail::kernel_tcp_info &get() const noexcept { return info_; }
+
+ private:
+  static constexpr pposix::microseconds microseconds_of(const uint64_t us) noexcept {
+    return pposix::microseconds{static_cast<pposix::microseconds::rep>(us)};
+  }
+
+  detail::kernel_tcp_info info_{};
+  socklen_t length_{0u};
+};
+
+// Read a tcp_info_snapshot for each socket into the matching element of snapshots, one
+// getsockopt per socket and no allocation, so a monitor can sweep every connection on a timer
+// with preallocated storage. Sockets whose snapshot could not be read (e.g. because they are not
+// TCP sockets) are left with a zero length. Returns the number of snapshots read.
+std::size_t sample_tcp_info(cspan<socket_fd> sockets, span<tcp_info_snapshot> snapshots) noexcept;
+#endif
+
 // Set socket option
 class socket {
  public:
@@ -231,94 +1011,164 @@ class socket {
   static pposix::result<socket> unsafe_make(socket_domain dom, socket_type typ, socket_flag flags,
                                             socket_protocol prot) noexcept;
 
-  std::error_code unsafe_setsockopt(socket_level, socket_option, any_cview) noexcept;
+  // Create a pair of connected sockets, e.g. to talk to a child process. Only socket_domain::unix_
+  // is supported on most systems.
+  static result<std::pair<socket, socket>> unsafe_make_pair(socket_domain dom, socket_type typ,
+                                                            socket_flag flags,
+                                                            socket_protocol prot) noexcept;
 
-  std::error_code setsockopt(socket_level, socket_debug) noexcept;
-  std::error_code setsockopt(socket_level, socket_broadcast) noexcept;
-  std::error_code setsockopt(socket_level, socket_reuseaddr) noexcept;
-  std::error_code setsockopt(socket_level, socket_keepalive) noexcept;
-  std::error_code setsockopt(socket_level, socket_linger) noexcept;
-  std::error_code setsockopt(socket_level, socket_oobinline) noexcept;
-  std::error_code setsockopt(socket_level, socket_sndbuf) noexcept;
-  std::error_code setsockopt(socket_level, socket_rcvbuf) noexcept;
-  std::error_code setsockopt(socket_level, socket_dontroute) noexcept;
-  std::error_code setsockopt(socket_level, socket_rcvlowat) noexcept;
-  std::error_code setsockopt(socket_level, socket_rcvtimeo) noexcept;
-  std::error_code setsockopt(socket_level, socket_sndlowat) noexcept;
-  std::error_code setsockopt(socket_level, socket_sndtimeo) noexcept;
+  socket_fd fd() const noexcept { return *socket_fd_; }
 
-  result<socklen_t> unsafe_getsockopt(socket_level, socket_option, any_view) noexcept;
+  std::error_code unsafe_bind(const ::sockaddr *address, socklen_t length) noexcept;
 
-  template <class T>
-  result<T> getsockopt(const socket_level l) noexcept {
-    if constexpr (std::is_same_v<T, socket_debug>) {
-      return getsockopt_bool<socket_debug>(l, socket_option::debug);
-    } else if (std::is_same_v<T, socket_broadcast>) {
-      return getsockopt_bool<socket_broadcast>(l, socket_option::broadcast);
-    } else if (std::is_same_v<T, socket_reuseaddr>) {
-      return getsockopt_bool<socket_reuseaddr>(l, socket_option::reuseaddr);
-    } else if (std::is_same_v<T, socket_acceptconn>) {
-      return getsockopt_bool<socket_acceptconn>(l, socket_option::acceptconn);
-    } else if (std::is_same_v<T, socket_keepalive>) {
-      return getsockopt_bool<socket_keepalive>(l, socket_option::keepalive);
-    } else if (std::is_same_v<T, socket_linger>) {
-      return getsockopt_struct<socket_linger>(l, socket_option::linger);
-    } else if (std::is_same_v<T, socket_oobinline>) {
-      return getsockopt_bool<socket_oobinline>(l, socket_option::oobinline);
-    } else if (std::is_same_v<T, socket_sndbuf>) {
-      return getsockopt_int<socket_sndbuf>(l, socket_option::sndbuf);
-    } else if (std::is_same_v<T, socket_rcvbuf>) {
-      return getsockopt_int<socket_rcvbuf>(l, socket_option::rcvbuf);
-    } else if (std::is_same_v<T, socket_error>) {
-      return getsockopt_int<socket_error>(l, socket_option::error);
-    } else if (std::is_same_v<T, socket_type>) {
-      return getsockopt_int<socket_type>(l, socket_option::type);
-    } else if (std::is_same_v<T, socket_dontroute>) {
-      return getsockopt_bool<socket_dontroute>(l, socket_option::dontroute);
-    } else if (std::is_same_v<T, socket_rcvlowat>) {
-      return getsockopt_int<socket_rcvlowat>(l, socket_option::rcvlowat);
-    } else if (std::is_same_v<T, socket_rcvtimeo>) {
-      return getsockopt_struct<socket_rcvtimeo>(l, socket_option::rcvtimeo);
-    } else if (std::is_same_v<T, socket_sndlowat>) {
-      return getsockopt_int<socket_sndlowat>(l, socket_option::sndlowat);
-    } else if (std::is_same_v<T, socket_sndtimeo>) {
-      return getsockopt_struct<socket_sndtimeo>(l, socket_option::sndtimeo);
-    } else {
-      static_assert(always_false<T>, "Unsupported socket option type.");
-    }
+  template <class Address>
+  std::error_code bind(const Address &address) noexcept {
+    return unsafe_bind(address.data(), address.length());
   }
 
- private:
-  std::error_code setsockopt_int(socket_level l, socket_option o, int i) noexcept;
-  std::error_code setsockopt_bool(socket_level l, socket_option o, bool b) noexcept;
+  std::error_code listen(int backlog) noexcept;
+
+  std::error_code unsafe_connect(const ::sockaddr *address, socklen_t length) noexcept;
 
-  template <class Result>
-  result<Result> getsockopt_int(socket_level l, socket_option o) noexcept {
-    int val{};
+  // On a non-blocking socket a stream connection completes in the background: this fails with
+  // operation_in_progress and the socket becomes writable once connected, with the outcome in
+  // socket_error.
+  template <class Address>
+  std::error_code connect(const Address &address) noexcept {
+    return unsafe_connect(address.data(), address.length());
+  }
+
+  // Accept a connection. On Linux the flags are applied atomically with accept4, so the new socket
+  // is never visible without close-on-exec.
+  result<socket> accept(socket_flag flags) noexcept;
+
+  // Also store the address of the peer.
+  result<socket> accept(socket_address &peer, socket_flag flags) noexcept;
+
+  result<socket_address> local_address() const noexcept;
+  result<socket_address> peer_address() const noexcept;
+
+  std::error_code unsafe_setsockopt(socket_level, socket_option, any_cview) noexcept;
+
+  // Set an option described by socket_option_traits.
+  template <class Option>
+  std::error_code setsockopt(const socket_level l, const Option &option) noexcept {
+    using traits = socket_option_traits<Option>;
+    static_assert(traits::settable, "This socket option can only be read.");
+
+    if (not traits::valid(option)) {
+      return make_errno_code(std::errc::invalid_argument);
+    }
 
-    const auto result = unsafe_getsockopt(l, o, any_view{&val});
-    return result_map<Result>(result, [&](int /*ignored*/) { return Result{val}; });
+    const typename traits::wire_type value{traits::to_wire(option)};
+    return unsafe_setsockopt(l, traits::name, any_cview{&value});
   }
 
-  template <class Result>
-  result<bool> getsockopt_bool(socket_level l, socket_option o) noexcept {
-    int val{};
+  // Set an option at its usual level.
+  template <class Option>
+  std::error_code setsockopt(const Option &option) noexcept {
+    return setsockopt(socket_option_traits<Option>::level, option);
+  }
 
-    const auto result = unsafe_getsockopt(l, o, any_view{&val});
-    return result_map<Result>(result, [&](int /*ignored*/) { return Result{val != 0}; });
+  // Set several options at their usual levels in order, stopping at the first failure, e.g. the
+  // same buffer sizes, nodelay, linger and timeouts on every accepted connection. Each option is
+  // one setsockopt call; nothing is looked up at run time.
+  template <class... Options>
+  std::error_code apply(const Options &...options) noexcept {
+    std::error_code error{};
+    static_cast<void>(((error = setsockopt(options), not error) and ...));
+    return error;
   }
 
-  template <class Result>
-  result<Result> getsockopt_struct(socket_level l, socket_option o) noexcept {
-    static_assert(std::is_class_v<Result>);
+  result<socklen_t> unsafe_getsockopt(socket_level, socket_option, any_view) noexcept;
+
+  // Gather the buffers into one message. Nothing is copied on the way into the kernel: the
+  // buffers are passed to it as an iovec array.
+  result<ssize_t> sendmsg(cspan<byte_cspan> buffers, message_flag flags) noexcept;
+
+  // Send control messages along with the data, e.g. built with a cmsg_writer.
+  result<ssize_t> sendmsg(cspan<byte_cspan> buffers, byte_cspan control,
+                          message_flag flags) noexcept;
+
+  // Scatter one message into the buffers.
+  result<received_message> recvmsg(span<byte_span> buffers, message_flag flags) noexcept;
+
+  // Also receive control messages into control, which must be aligned for cmsghdr.
+  result<received_message> recvmsg(span<byte_span> buffers, byte_span control,
+                                   message_flag flags) noexcept;
+
+#if PPOSIX_LINUX_EXTENSION_ENABLED
+  // Receive up to messages.length() datagrams with a single system call. Returns the number of
+  // messages filled in. Pass message_flag::waitforone to return as soon as one message has been
+  // received instead of blocking until the batch is full.
+  result<std::size_t> recv_batch(span<batch_message> messages, message_flag flags) noexcept;
+
+  // Send the messages with a single system call. Returns the number of messages sent, which is
+  // less than requested if the socket buffer filled up or a later message failed.
+  result<std::size_t> send_batch(span<batch_message> messages, message_flag flags) noexcept;
 
-    Result val{};
+  result<tcp_info_snapshot> tcp_info() const noexcept { return tcp_info_snapshot::read(fd()); }
 
-    const auto result = unsafe_getsockopt(l, o, any_view{&val});
-    return result_map<Result>(result, [&](int /*ignored*/) { return val; });
+  // Bytes received but not read yet (SIOCINQ).
+  result<int> input_queue() const noexcept;
+
+  // Bytes written but not acknowledged by the peer yet, including those not sent yet (SIOCOUTQ).
+  result<int> output_queue() const noexcept;
+
+  // Bytes written but not sent yet (SIOCOUTQNSD).
+  result<int> unsent_queue() const noexcept;
+#endif
+
+  template <class Option>
+  result<Option> getsockopt(const socket_level l) noexcept {
+    using traits = socket_option_traits<Option>;
+    static_assert(traits::gettable, "This socket option can only be set.");
+
+    typename traits::wire_type value{};
+    const auto result = unsafe_getsockopt(l, traits::name, any_view{&value});
+    return result_map<Option>(
+        result, [&](socklen_t /*ignored*/) noexcept { return traits::from_wire(value); });
+  }
+
+  // Get an option from its usual level.
+  template <class Option>
+  result<Option> getsockopt() noexcept {
+    return getsockopt<Option>(socket_option_traits<Option>::level);
   }
 
  private:
   unique_socket_fd socket_fd_{};
 };
+
+// Accept connections from a non-blocking listening socket until none are left, passing each new
+// socket to on_accept. Call it on every readiness event: with edge-triggered notifications
+// anything left unaccepted would not be reported again. Connections aborted before they could be
+// accepted are skipped. Returns the number accepted; an error stops the loop but the sockets
+// accepted before it have already been handed to on_accept.
+template <class OnAccept>
+result<std::size_t> drain_accept(socket &listener, const socket_flag flags,
+                                 OnAccept &&on_accept) noexcept {
+  static_assert(noexcept(on_accept(std::declval<socket>())));
+
+  std::size_t accepted{0u};
+  while (true) {
+    auto s{listener.accept(flags)};
+    if (s) {
+      on_accept(std::move(s.value()));
+      ++accepted;
+      continue;
+    }
+
+    const std::error_code error{s.error()};
+    if (error == std::errc::resource_unavailable_try_again or
+        error == std::errc::operation_would_block) {
+      return accepted;
+    }
+
+    if (error != std::errc::connection_aborted and error != std::errc::interrupted) {
+      return error;
+    }
+  }
+}
+
 }  // namespace pposix
\ No newline at end of file
@@ -0,0 +1,33 @@
+#pragma once
+
+#include <sys/uio.h>
+
+#include <type_traits>
+
+#include "pposix/byte_span.hpp"
+#include "pposix/span.hpp"
+
+namespace pposix {
+
+// byte_span and byte_cspan are laid out like iovec (a pointer followed by a length), so a span of
+// them is handed to the scatter/gather calls as an iovec array without copying.
+static_assert(std::is_standard_layout_v<byte_span> and std::is_trivially_copyable_v<byte_span>);
+static_assert(sizeof(byte_span) == sizeof(::iovec) and alignof(byte_span) == alignof(::iovec));
+
+static_assert(std::is_standard_layout_v<byte_cspan> and std::is_trivially_copyable_v<byte_cspan>);
+static_assert(sizeof(byte_cspan) == sizeof(::iovec) and alignof(byte_cspan) == alignof(::iovec));
+
+namespace detail {
+
+inline ::iovec *as_iovec(span<byte_span> buffers) noexcept {
+  return reinterpret_cast<::iovec *>(buffers.data());
+}
+
+// The kernel never writes through the iovecs of an output call, so dropping const is safe.
+inline ::iovec *as_iovec(cspan<byte_cspan> buffers) noexcept {
+  return reinterpret_cast<::iovec *>(const_cast<byte_cspan *>(buffers.data()));
+}
+
+}  // namespace detail
+
+}  // namespace pposix
@@ -0,0 +1,56 @@
+#include "pposix/address.hpp"
+
+#include <cstring>
+
+#include "pposix/errno.hpp"
+
+namespace pposix {
+
+result<unix_address> unix_address::create(const std::string_view path) noexcept {
+  unix_address address{};
+  if (path.size() >= sizeof(address.address_.sun_path)) {
+    return make_errno_code(std::errc::filename_too_long);
+  }
+
+  address.address_.sun_family = AF_UNIX;
+  std::memcpy(address.address_.sun_path, path.data(), path.size());
+
+  // A path starting with a null byte is in the abstract namespace and is not null terminated.
+  const bool abstract{not path.empty() and path.front() == '\0'};
+  address.length_ = static_cast<socklen_t>(offsetof(::sockaddr_un, sun_path) + path.size() +
+                                           (abstract ? 0u : 1u));
+  return address;
+}
+
+std::string_view unix_address::path() const noexcept {
+  const std::size_t size{length_ - offsetof(::sockaddr_un, sun_path)};
+  if (size == 0u) {
+    return {};
+  }
+
+  // Drop the null terminator of a filesystem path.
+  const bool abstract{address_.sun_path[0] == '\0'};
+  return {address_.sun_path, abstract ? size : size - 1u};
+}
+
+std::optional<inet_address> socket_address::inet() const noexcept {
+  if (storage_.ss_family != AF_INET) {
+    return std::nullopt;
+  }
+
+  ::sockaddr_in address{};
+  std::memcpy(&address, &storage_, sizeof(address));
+  return inet_address{address};
+}
+
+std::optional<inet6_address> socket_address::inet6() const noexcept {
+  if (storage_.ss_family != AF_INET6) {
+    return std::nullopt;
+  }
+
+  ::sockaddr_in6 address{};
+  std::memcpy(&address, &storage_, sizeof(address));
+  return inet6_address{address};
+}
+
+}  // namespace pposix
@@ -0,0 +1,70 @@
+#include "pposix/cmsg.hpp"
+
+#include <cstdint>
+
+#include "pposix/errno.hpp"
+#include "pposix/socket.hpp"
+#include "pposix/util.hpp"
+
+namespace pposix {
+
+byte_cspan cmsg::data() const noexcept {
+  return byte_cspan{reinterpret_cast<const std::byte *>(CMSG_DATA(header_)),
+                    header_->cmsg_len - CMSG_LEN(0)};
+}
+
+cmsg_range::iterator &cmsg_range::iterator::operator++() noexcept {
+  header_ = CMSG_NXTHDR(&message_, const_cast<::cmsghdr *>(header_));
+  return *this;
+}
+
+cmsg_range::iterator cmsg_range::begin() const noexcept {
+  ::msghdr message{};
+  message.msg_control = const_cast<std::byte *>(control_.data());
+  message.msg_controllen = control_.length();
+
+  if (const ::cmsghdr *const first{CMSG_FIRSTHDR(&message)}; first != nullptr) {
+    return iterator{message, first};
+  } else {
+    return end();
+  }
+}
+
+std::error_code cmsg_writer::add(const socket_level level, const int type,
+                                 const byte_cspan data) noexcept {
+  auto message{append(level, type, data.length())};
+  if (not message) {
+    return message.error();
+  }
+
+  if (not data.empty()) {
+    std::memcpy(message->data(), data.data(), data.length());
+  }
+
+  return {};
+}
+
+result<byte_span> cmsg_writer::append(const socket_level level, const int type,
+                                      const std::size_t length) noexcept {
+  if (reinterpret_cast<std::uintptr_t>(buffer_.data()) % alignof(::cmsghdr) != 0u) {
+    return make_errno_code(std::errc::invalid_argument);
+  }
+
+  const std::size_t space{CMSG_SPACE(length)};
+  if (buffer_.length() - used_ < space) {
+    return make_errno_code(std::errc::no_buffer_space);
+  }
+
+  std::byte *const start{buffer_.data() + used_};
+  std::memset(start, 0, space);
+
+  auto *const header{reinterpret_cast<::cmsghdr *>(start)};
+  header->cmsg_level = underlying_v(level);
+  header->cmsg_type = type;
+  header->cmsg_len = CMSG_LEN(length);
+
+  used_ += space;
+  return byte_span{reinterpret_cast<std::byte *>(CMSG_DATA(header)), length};
+}
+
+}  // namespace pposix
@@ -0,0 +1,94 @@
+#include "pposix/fd_channel.hpp"
+
+#include <cstring>
+
+#include "pposix/cmsg.hpp"
+#include "pposix/errno.hpp"
+
+namespace pposix {
+
+namespace {
+
+constexpr std::size_t control_space{cmsg_space(sizeof(int) * fd_channel::max_fds)};
+
+}  // namespace
+
+fd_channel::fd_channel(socket s) noexcept : socket_{std::move(s)} {}
+
+result<std::pair<fd_channel, fd_channel>> fd_channel::create_pair(
+    const socket_flag flags) noexcept {
+  auto sockets{socket::unsafe_make_pair(socket_domain::unix_, socket_type::seqpacket, flags,
+                                        socket_protocol{0})};
+  if (not sockets) {
+    return sockets.error();
+  }
+
+  return std::pair<fd_channel, fd_channel>{fd_channel{std::move(sockets->first)},
+                                           fd_channel{std::move(sockets->second)}};
+}
+
+result<std::size_t> fd_channel::send_fds(const void *const batch, const std::size_t fd_count,
+                                         const fd_reader fd_at, const byte_cspan payload,
+                                         const message_flag flags) noexcept {
+  alignas(::cmsghdr) std::byte control[control_space];
+  cmsg_writer writer{byte_span{control, sizeof(control)}};
+  if (fd_count > 0u) {
+    auto data{writer.append(socket_level::socket, SCM_RIGHTS, sizeof(int) * fd_count)};
+    if (not data) {
+      return data.error();
+    }
+
+    for (std::size_t i = 0u; i < fd_count; ++i) {
+      const int fd{fd_at(batch, i)};
+      std::memcpy(data->data() + sizeof(int) * i, &fd, sizeof(fd));
+    }
+  }
+
+  const byte_cspan buffers[]{payload};
+  const auto sent{socket_.sendmsg(cspan<byte_cspan>{buffers, 1u}, writer.data(), flags)};
+  if (not sent) {
+    return sent.error();
+  }
+
+  return static_cast<std::size_t>(*sent);
+}
+
+result<received_fds> fd_channel::receive(const byte_span payload, span<file_descriptor> fds,
+                                         const message_flag flags) noexcept {
+  alignas(::cmsghdr) std::byte control[control_space];
+  const std::size_t fd_capacity{fds.length() < max_fds ? fds.length() : max_fds};
+
+  // Sized exactly rather than with cmsg_space, whose padding can leave room for one more
+  // descriptor: the kernel fills in as many as fit and closes the rest.
+  const std::size_t control_length{fd_capacity == 0u ? 0u : CMSG_LEN(sizeof(int) * fd_capacity)};
+
+  byte_span buffers[]{payload};
+  const auto received{socket_.recvmsg(span<byte_span>{buffers, 1u},
+                                      byte_span{control, control_length}, flags)};
+  if (not received) {
+    return received.error();
+  }
+
+  std::size_t fd_count{0u};
+  for (const cmsg message : received->control()) {
+    if (message.level() != socket_level::socket or message.type() != SCM_RIGHTS) {
+      continue;
+    }
+
+    const byte_cspan data{message.data()};
+    for (std::size_t offset = 0u; offset + sizeof(int) <= data.length(); offset += sizeof(int)) {
+      int fd{};
+      std::memcpy(&fd, data.data() + offset, sizeof(fd));
+
+      if (fd_count < fd_capacity) {
+        fds.data()[fd_count++] = file_descriptor{raw_fd{fd}};
+      } else {
+        static_cast<void>(close_fd(raw_fd{fd}));
+      }
+    }
+  }
+
+  return received_fds{received->bytes(), fd_count, received->flags()};
+}
+
+}  // namespace pposix
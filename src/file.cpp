@@ -1,6 +1,7 @@
 #include "pposix/file.hpp"
 
 #include "pposix/fcntl.hpp"
+#include "pposix/uio.hpp"
 #include "pposix/util.hpp"
 
 namespace pposix {
@@ -28,4 +29,14 @@ result<ssize_t> file::write(const byte_cspan buffer) noexcept {
   PPOSIX_COMMON_RESULT_CALL_IMPL(::write, static_cast<raw_fd_t>(*fd_), buffer.data(),
                                  buffer.length())
 }
+
+result<ssize_t> file::readv(span<byte_span> buffers) noexcept {
+  PPOSIX_COMMON_RESULT_CALL_IMPL(::readv, static_cast<raw_fd_t>(*fd_), detail::as_iovec(buffers),
+                                 static_cast<int>(buffers.length()))
+}
+
+result<ssize_t> file::writev(const cspan<byte_cspan> buffers) noexcept {
+  PPOSIX_COMMON_RESULT_CALL_IMPL(::writev, static_cast<raw_fd_t>(*fd_), detail::as_iovec(buffers),
+                                 static_cast<int>(buffers.length()))
+}
 }  // namespace pposix
\ No newline at end of file
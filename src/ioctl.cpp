@@ -12,15 +12,15 @@
 namespace pposix {
 
 result<ioctl_int> ioctl(raw_fd fd, ioctl_request r, int i) noexcept {
-  return PPOSIX_COMMON_CALL(::ioctl, static_cast<raw_fd_t>(fd), underlying_v(r), i);
+  PPOSIX_COMMON_RESULT_CALL_IMPL(::ioctl, static_cast<raw_fd_t>(fd), underlying_v(r), i)
 }
 
 result<ioctl_int> ioctl(raw_fd fd, ioctl_request r, void *ptr) noexcept {
-  return PPOSIX_COMMON_CALL(::ioctl, static_cast<raw_fd_t>(fd), underlying_v(r), ptr);
+  PPOSIX_COMMON_RESULT_CALL_IMPL(::ioctl, static_cast<raw_fd_t>(fd), underlying_v(r), ptr)
 }
 
 result<ioctl_int> ioctl(raw_fd fd, ioctl_request r, const void *ptr) noexcept {
-  return PPOSIX_COMMON_CALL(::ioctl, static_cast<raw_fd_t>(fd), underlying_v(r), ptr);
+  PPOSIX_COMMON_RESULT_CALL_IMPL(::ioctl, static_cast<raw_fd_t>(fd), underlying_v(r), ptr)
 }
 
 result<ioctl_int> ioctl(raw_fd fd, ioctl_request r, std::nullptr_t) noexcept {
@@ -1,12 +1,32 @@
 #include "pposix/lnx/epoll.hpp"
 
+#include <sys/syscall.h>
 #include <unistd.h>
 
+#include <algorithm>
+#include <atomic>
+#include <climits>
+
 #include "pposix/errno.hpp"
 #include "pposix/util.hpp"
 
 namespace pposix::lnx {
 
+namespace {
+
+constexpr long nanoseconds_per_second{1'000'000'000L};
+constexpr long nanoseconds_per_millisecond{1'000'000L};
+
+// Set once epoll_pwait2 fails with ENOSYS so later waits go straight to the fallback.
+std::atomic<bool> epoll_pwait2_unsupported{false};
+
+// The waits take the number of events as an int; a larger buffer is only filled up to INT_MAX.
+int max_events(const span<lnx::epoll_event> events) noexcept {
+  return static_cast<int>(std::min<std::size_t>(events.length(), INT_MAX));
+}
+
+}  // namespace
+
 namespace capi {
 
 epoll_event::epoll_event(epoll_event_flag event_flags) noexcept : ::epoll_event{} {
@@ -90,19 +110,219 @@ std::error_code epoll::ctl(epoll_modify mod) noexcept {
   return unsafe_ctl(capi::epoll_operation::modify, mod.fd(), mod.event_ptr());
 }
 
+// Deferred interest list updates
+detail::epoll_interest &epoll::deferred_interest(const raw_fd fd) noexcept {
+  const auto index{static_cast<std::size_t>(static_cast<raw_fd_t>(fd))};
+  if (index >= interest_.size()) {
+    interest_.resize(index + 1u);
+  }
+
+  detail::epoll_interest &state{interest_[index]};
+  if (not state.dirty) {
+    state.dirty = true;
+    dirty_.push_back(static_cast<raw_fd_t>(fd));
+  }
+
+  ++ctl_stats_.deferred;
+  return state;
+}
+
+std::error_code epoll::defer_ctl(const epoll_add add) noexcept {
+  if (static_cast<raw_fd_t>(add.fd) < 0) {
+    return make_errno_code(std::errc::bad_file_descriptor);
+  }
+
+  detail::epoll_interest &state{deferred_interest(add.fd)};
+  state.pending = detail::epoll_interest::intent::add;
+  state.desired = add.event;
+
+  return {};
+}
+
+std::error_code epoll::defer_ctl(const epoll_remove remove) noexcept {
+  if (static_cast<raw_fd_t>(remove.fd) < 0) {
+    return make_errno_code(std::errc::bad_file_descriptor);
+  }
+
+  detail::epoll_interest &state{deferred_interest(remove.fd)};
+  if (state.pending == detail::epoll_interest::intent::add) {
+    // Removing a descriptor that was added in the same batch cancels the add.
+    state.pending = detail::epoll_interest::intent::none;
+  } else {
+    state.pending = detail::epoll_interest::intent::none;
+    state.removed = true;
+  }
+
+  return {};
+}
+
+std::error_code epoll::defer_ctl(epoll_modify mod) noexcept {
+  if (static_cast<raw_fd_t>(mod.fd()) < 0) {
+    return make_errno_code(std::errc::bad_file_descriptor);
+  }
+
+  detail::epoll_interest &state{deferred_interest(mod.fd())};
+  if (state.pending != detail::epoll_interest::intent::add) {
+    state.pending = detail::epoll_interest::intent::modify;
+  }
+
+  state.desired = *mod.event_ptr();
+
+  return {};
+}
+
+namespace {
+
+bool same_interest(const capi::epoll_event &lhs, const capi::epoll_event &rhs) noexcept {
+  // A one shot descriptor is disabled by the kernel after it fires, so re-arming it is never
+  // redundant.
+  return lhs.events == rhs.events and lhs.data.u64 == rhs.data.u64 and
+         not(rhs.events & underlying_v(capi::epoll_event_flag::one_shot));
+}
+
+}  // namespace
+
+std::error_code epoll::flush() noexcept {
+  std::error_code first_error{};
+
+  const auto issue{[&](const capi::epoll_operation op, const raw_fd fd,
+                       capi::epoll_event *event) noexcept {
+    ++ctl_stats_.issued;
+    return unsafe_ctl(op, fd, event);
+  }};
+
+  const auto fail{[&](const raw_fd_t fd_number, const std::error_code error) noexcept {
+    ++ctl_stats_.failed;
+    ctl_stats_.last_failed_fd = fd_number;
+    ctl_stats_.last_error = error;
+
+    if (not first_error) {
+      first_error = error;
+    }
+  }};
+
+  for (const raw_fd_t fd_number : dirty_) {
+    detail::epoll_interest &state{interest_[static_cast<std::size_t>(fd_number)]};
+    const raw_fd fd{fd_number};
+
+    if (state.removed) {
+      // EBADF and ENOENT mean the descriptor was closed after the remove was recorded.
+      if (const auto error = issue(capi::epoll_operation::remove, fd, nullptr);
+          error and error != std::errc::bad_file_descriptor and
+          error != std::errc::no_such_file_or_directory) {
+        fail(fd_number, error);
+      }
+
+      state.registered = false;
+    }
+
+    switch (state.pending) {
+      case detail::epoll_interest::intent::add:
+        if (const auto error = issue(capi::epoll_operation::add, fd, &state.desired)) {
+          fail(fd_number, error);
+        } else {
+          state.registered = true;
+          state.committed = state.desired;
+        }
+        break;
+
+      case detail::epoll_interest::intent::modify:
+        if (state.registered and same_interest(state.committed, state.desired)) {
+          break;
+        }
+
+        if (const auto error = issue(capi::epoll_operation::modify, fd, &state.desired)) {
+          fail(fd_number, error);
+        } else {
+          state.committed = state.desired;
+        }
+        break;
+
+      case detail::epoll_interest::intent::none:
+        break;
+    }
+
+    state.pending = detail::epoll_interest::intent::none;
+    state.removed = false;
+    state.dirty = false;
+  }
+
+  dirty_.clear();
+  return first_error;
+}
+
 result<int> epoll::wait(span<lnx::epoll_event> events, milliseconds timeout) noexcept {
-  // TODO: Assert that events.length() <= std::numeric_literals<int>::max()
+  // A failed update belongs to one descriptor and is counted in ctl_stats(); it must not stop
+  // the wait for all the others.
+  if (not dirty_.empty()) {
+    (void)flush();
+  }
 
-  return PPOSIX_COMMON_CALL(::epoll_wait, static_cast<raw_fd_t>(*epoll_fd_), events.data(),
-                            events.length(), timeout.count());
+  PPOSIX_COMMON_RESULT_CALL_IMPL(::epoll_wait, static_cast<raw_fd_t>(*epoll_fd_), events.data(),
+                                 max_events(events), timeout.count())
 }
 
 result<int> epoll::pwait(span<lnx::epoll_event> events, milliseconds timeout,
                          const sigset &sigmask) noexcept {
-  // TODO: Assert that events.length() <= std::numeric_literals<int>::max()
+  if (not dirty_.empty()) {
+    (void)flush();
+  }
+
+  PPOSIX_COMMON_RESULT_CALL_IMPL(::epoll_pwait, static_cast<raw_fd_t>(*epoll_fd_), events.data(),
+                                 max_events(events), timeout.count(), sigmask.sigset_ptr())
+}
+
+result<int> epoll::pwait2(span<lnx::epoll_event> events, const nanoseconds timeout,
+                          const sigset &sigmask) noexcept {
+  if (timeout.count() < 0) {
+    return unsafe_pwait2(events, nullptr, sigmask);
+  }
+
+  ::timespec ts{};
+  ts.tv_sec = static_cast<time_t>(timeout.count() / nanoseconds_per_second);
+  ts.tv_nsec = timeout.count() % nanoseconds_per_second;
+  return unsafe_pwait2(events, &ts, sigmask);
+}
+
+result<int> epoll::pwait2(span<lnx::epoll_event> events, const timespec &timeout,
+                          const sigset &sigmask) noexcept {
+  return unsafe_pwait2(events, &timeout, sigmask);
+}
+
+result<int> epoll::unsafe_pwait2(span<lnx::epoll_event> events, const ::timespec *timeout,
+                                 const sigset &sigmask) noexcept {
+  if (not dirty_.empty()) {
+    (void)flush();
+  }
+
+#ifdef __NR_epoll_pwait2
+  if (not epoll_pwait2_unsupported.load(std::memory_order_relaxed)) {
+    // Called directly rather than through glibc, which only gained a wrapper in 2.35. The kernel
+    // expects the size of its own sigset, not of sigset_t.
+    const long res{::syscall(__NR_epoll_pwait2, static_cast<raw_fd_t>(*epoll_fd_), events.data(),
+                             max_events(events), timeout, sigmask.sigset_ptr(),
+                             _NSIG / 8)};
+    if (res != -1) {
+      return static_cast<int>(res);
+    } else if (errno != ENOSYS) {
+      return current_errno_code();
+    }
+
+    epoll_pwait2_unsupported.store(true, std::memory_order_relaxed);
+  }
+#endif
+
+  int timeout_ms{-1};
+  if (timeout != nullptr) {
+    // Round up so the fallback never wakes up before the requested timeout.
+    const long long total_ns{static_cast<long long>(timeout->tv_sec) * nanoseconds_per_second +
+                             timeout->tv_nsec};
+    const long long ms{(total_ns + nanoseconds_per_millisecond - 1) / nanoseconds_per_millisecond};
+    timeout_ms = static_cast<int>(ms > INT_MAX ? INT_MAX : ms);
+  }
 
-  return PPOSIX_COMMON_CALL(::epoll_pwait, static_cast<raw_fd_t>(*epoll_fd_), events.data(),
-                            events.length(), timeout.count(), sigmask.sigset_ptr());
+  PPOSIX_COMMON_RESULT_CALL_IMPL(::epoll_pwait, static_cast<raw_fd_t>(*epoll_fd_), events.data(),
+                                 max_events(events), timeout_ms, sigmask.sigset_ptr())
 }
 
 }  // namespace pposix::lnx
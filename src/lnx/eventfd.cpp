@@ -0,0 +1,34 @@
+#include "pposix/lnx/eventfd.hpp"
+
+#include <unistd.h>
+
+#include "pposix/errno.hpp"
+#include "pposix/util.hpp"
+
+namespace pposix::lnx {
+
+eventfd::eventfd(const raw_fd fd) noexcept : fd_{fd} {}
+
+result<eventfd> eventfd::unsafe_create(const unsigned initial_value,
+                                       const capi::eventfd_flag flags) noexcept {
+  if (const auto fd{::eventfd(initial_value, underlying_v(flags))}; fd == -1) {
+    return current_errno_code();
+  } else {
+    return eventfd{raw_fd{fd}};
+  }
+}
+
+std::error_code eventfd::write(const uint64_t value) noexcept {
+  return PPOSIX_COMMON_CALL(::write, static_cast<raw_fd_t>(*fd_), &value, sizeof(value));
+}
+
+result<uint64_t> eventfd::read() noexcept {
+  uint64_t value{};
+  if (::read(static_cast<raw_fd_t>(*fd_), &value, sizeof(value)) == -1) {
+    return current_errno_code();
+  } else {
+    return value;
+  }
+}
+
+}  // namespace pposix::lnx
@@ -0,0 +1,237 @@
+#include "pposix/lnx/io_uring.hpp"
+
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cstring>
+
+#include "pposix/errno.hpp"
+#include "pposix/util.hpp"
+
+namespace pposix::lnx {
+
+namespace {
+
+// The ring indices are shared with the kernel, so they have to be accessed with the same ordering
+// guarantees the kernel uses for its side of the ring.
+unsigned load_acquire(const unsigned *ptr) noexcept {
+  return __atomic_load_n(ptr, __ATOMIC_ACQUIRE);
+}
+
+void store_release(unsigned *ptr, const unsigned value) noexcept {
+  __atomic_store_n(ptr, value, __ATOMIC_RELEASE);
+}
+
+template <class T>
+T *ring_offset(void *base, const uint32_t offset) noexcept {
+  return reinterpret_cast<T *>(static_cast<std::byte *>(base) + offset);
+}
+
+result<unique_mmap_d> map_ring(const raw_fd fd, const size_t length, const off_t offset) noexcept {
+  return result_map<unique_mmap_d>(
+      pposix::capi::mmap_map(nullptr, length, mmap_read | mmap_write, mmap_shared, fd, offset),
+      [](const mmap_d d) noexcept { return unique_mmap_d{d}; });
+}
+
+}  // namespace
+
+io_uring::io_uring(file_descriptor ring_fd, unique_mmap_d sq_ring, unique_mmap_d cq_ring,
+                   unique_mmap_d sqes, const ::io_uring_params &params) noexcept
+    : ring_fd_{std::move(ring_fd)},
+      sq_ring_{std::move(sq_ring)},
+      cq_ring_{std::move(cq_ring)},
+      sqes_{std::move(sqes)},
+      setup_flags_{params.flags},
+      sq_entries_{params.sq_entries},
+      cq_entries_{params.cq_entries} {
+  void *const sq_base{sq_ring_->address()};
+  void *const cq_base{cq_ring_.empty() ? sq_base : cq_ring_->address()};
+
+  sq_head_ = ring_offset<unsigned>(sq_base, params.sq_off.head);
+  sq_tail_ = ring_offset<unsigned>(sq_base, params.sq_off.tail);
+  sq_mask_ = ring_offset<unsigned>(sq_base, params.sq_off.ring_mask);
+  sq_flags_ = ring_offset<unsigned>(sq_base, params.sq_off.flags);
+  sqe_array_ = static_cast<::io_uring_sqe *>(sqes_->address());
+  sqe_tail_ = *sq_tail_;
+
+  // Every submission queue slot permanently points at the entry with the same index, so submitting
+  // only has to fill in the entry and bump the tail.
+  unsigned *const sq_array{ring_offset<unsigned>(sq_base, params.sq_off.array)};
+  for (unsigned i = 0u; i < sq_entries_; ++i) {
+    sq_array[i] = i;
+  }
+
+  cq_head_ = ring_offset<unsigned>(cq_base, params.cq_off.head);
+  cq_tail_ = ring_offset<unsigned>(cq_base, params.cq_off.tail);
+  cq_mask_ = ring_offset<unsigned>(cq_base, params.cq_off.ring_mask);
+  cqe_array_ = ring_offset<::io_uring_cqe>(cq_base, params.cq_off.cqes);
+}
+
+result<io_uring> io_uring::unsafe_create(const unsigned entries,
+                                         const capi::io_uring_setup_flag flags) noexcept {
+  ::io_uring_params params{};
+  params.flags = underlying_v(flags);
+
+  const auto ring_fd_res{::syscall(__NR_io_uring_setup, entries, &params)};
+  if (ring_fd_res == -1) {
+    return current_errno_code();
+  }
+
+  file_descriptor ring_fd{raw_fd{static_cast<raw_fd_t>(ring_fd_res)}};
+
+  size_t sq_ring_length{params.sq_off.array + params.sq_entries * sizeof(unsigned)};
+  const size_t cq_ring_length{params.cq_off.cqes + params.cq_entries * sizeof(::io_uring_cqe)};
+
+  const bool single_mmap{(params.features & IORING_FEAT_SINGLE_MMAP) != 0u};
+  if (single_mmap) {
+    sq_ring_length = std::max(sq_ring_length, cq_ring_length);
+  }
+
+  auto sq_ring{map_ring(*ring_fd, sq_ring_length, IORING_OFF_SQ_RING)};
+  if (not sq_ring) {
+    return sq_ring.error();
+  }
+
+  unique_mmap_d cq_ring{};
+  if (not single_mmap) {
+    auto cq_ring_res{map_ring(*ring_fd, cq_ring_length, IORING_OFF_CQ_RING)};
+    if (not cq_ring_res) {
+      return cq_ring_res.error();
+    }
+
+    cq_ring = std::move(cq_ring_res.value());
+  }
+
+  auto sqes{map_ring(*ring_fd, params.sq_entries * sizeof(::io_uring_sqe), IORING_OFF_SQES)};
+  if (not sqes) {
+    return sqes.error();
+  }
+
+  return io_uring{std::move(ring_fd), std::move(sq_ring.value()), std::move(cq_ring),
+                  std::move(sqes.value()), params};
+}
+
+result<io_uring> io_uring::create(const unsigned entries) noexcept {
+  return unsafe_create(entries, io_uring_default);
+}
+
+unsigned io_uring::pending() const noexcept { return sqe_tail_ - load_acquire(sq_head_); }
+
+::io_uring_sqe *io_uring::next_sqe() noexcept {
+  if (pending() >= sq_entries_) {
+    return nullptr;
+  }
+
+  ::io_uring_sqe *const sqe{&sqe_array_[sqe_tail_ & *sq_mask_]};
+  std::memset(sqe, 0, sizeof(::io_uring_sqe));
+  ++sqe_tail_;
+
+  return sqe;
+}
+
+namespace {
+
+std::error_code prep_rw(::io_uring_sqe *const sqe, const capi::io_uring_op op, const raw_fd_t fd,
+                        const void *const addr, const size_t len, const off_t offset,
+                        const uint64_t user_data) noexcept {
+  if (sqe == nullptr) {
+    return make_errno_code(std::errc::resource_unavailable_try_again);
+  }
+
+  sqe->opcode = underlying_v(op);
+  sqe->fd = fd;
+  sqe->off = static_cast<uint64_t>(offset);
+  sqe->addr = reinterpret_cast<uint64_t>(addr);
+  sqe->len = static_cast<uint32_t>(len);
+  sqe->user_data = user_data;
+
+  return {};
+}
+
+}  // namespace
+
+std::error_code io_uring::nop(const uint64_t user_data) noexcept {
+  return prep_rw(next_sqe(), capi::io_uring_op::nop, -1, nullptr, 0u, 0, user_data);
+}
+
+std::error_code io_uring::read(const raw_fd fd, byte_span buffer, const off_t offset,
+                               const uint64_t user_data) noexcept {
+  return prep_rw(next_sqe(), capi::io_uring_op::read, static_cast<raw_fd_t>(fd), buffer.data(),
+                 buffer.length(), offset, user_data);
+}
+
+std::error_code io_uring::write(const raw_fd fd, const byte_cspan buffer, const off_t offset,
+                                const uint64_t user_data) noexcept {
+  return prep_rw(next_sqe(), capi::io_uring_op::write, static_cast<raw_fd_t>(fd), buffer.data(),
+                 buffer.length(), offset, user_data);
+}
+
+std::error_code io_uring::accept(const socket_fd fd, const socket_flag flags,
+                                 const uint64_t user_data) noexcept {
+  ::io_uring_sqe *const sqe{next_sqe()};
+  if (const auto error =
+          prep_rw(sqe, capi::io_uring_op::accept, underlying_v(fd), nullptr, 0u, 0, user_data)) {
+    return error;
+  }
+
+  sqe->accept_flags = underlying_v(flags);
+  return {};
+}
+
+std::error_code io_uring::recv(const socket_fd fd, byte_span buffer,
+                               const uint64_t user_data) noexcept {
+  return prep_rw(next_sqe(), capi::io_uring_op::recv, underlying_v(fd), buffer.data(),
+                 buffer.length(), 0, user_data);
+}
+
+std::error_code io_uring::send(const socket_fd fd, const byte_cspan buffer,
+                               const uint64_t user_data) noexcept {
+  return prep_rw(next_sqe(), capi::io_uring_op::send, underlying_v(fd), buffer.data(),
+                 buffer.length(), 0, user_data);
+}
+
+result<int> io_uring::enter(const unsigned to_submit, const unsigned min_complete,
+                            unsigned flags) noexcept {
+  // Publish every prepared entry before the kernel (or the SQ polling thread) looks at the ring.
+  store_release(sq_tail_, sqe_tail_);
+
+  if (setup_flags_ & IORING_SETUP_SQPOLL) {
+    if (load_acquire(sq_flags_) & IORING_SQ_NEED_WAKEUP) {
+      flags |= IORING_ENTER_SQ_WAKEUP;
+    } else if (not(flags & IORING_ENTER_GETEVENTS)) {
+      // The polling thread is awake and will pick up the entries on its own.
+      return static_cast<int>(to_submit);
+    }
+  }
+
+  const auto res{::syscall(__NR_io_uring_enter, static_cast<raw_fd_t>(*ring_fd_), to_submit,
+                           min_complete, flags, nullptr, 0u)};
+  if (res == -1) {
+    return current_errno_code();
+  } else {
+    return static_cast<int>(res);
+  }
+}
+
+result<int> io_uring::submit() noexcept { return enter(pending(), 0u, 0u); }
+
+result<int> io_uring::submit_and_wait(const unsigned min_complete) noexcept {
+  return enter(pending(), min_complete, IORING_ENTER_GETEVENTS);
+}
+
+std::size_t io_uring::reap(span<io_uring_completion> completions) noexcept {
+  const unsigned head{*cq_head_};
+  const unsigned available{load_acquire(cq_tail_) - head};
+
+  const auto count{std::min<std::size_t>(available, completions.length())};
+  for (std::size_t i = 0u; i < count; ++i) {
+    const ::io_uring_cqe &cqe{cqe_array_[(head + i) & *cq_mask_]};
+    completions.data()[i] = io_uring_completion{cqe.user_data, cqe.res, cqe.flags};
+  }
+
+  store_release(cq_head_, head + static_cast<unsigned>(count));
+  return count;
+}
+
+}  // namespace pposix::lnx
@@ -0,0 +1,152 @@
+#include "pposix/lnx/packet_ring.hpp"
+
+#include <unistd.h>
+
+#include <utility>
+
+#include "pposix/errno.hpp"
+#include "pposix/util.hpp"
+
+namespace pposix::lnx {
+
+namespace {
+
+uint32_t load_status(const ::tpacket_block_desc *block) noexcept {
+  return __atomic_load_n(&block->hdr.bh1.block_status, __ATOMIC_ACQUIRE);
+}
+
+}  // namespace
+
+// packet_block
+
+packet_block::packet_block(packet_block &&other) noexcept
+    : block_{std::exchange(other.block_, nullptr)} {}
+
+packet_block &packet_block::operator=(packet_block &&other) noexcept {
+  if (this != &other) {
+    release();
+    block_ = std::exchange(other.block_, nullptr);
+  }
+
+  return *this;
+}
+
+packet_block::iterator packet_block::begin() const noexcept {
+  if (block_ == nullptr) {
+    return {};
+  }
+
+  const uint32_t count{block_->hdr.bh1.num_pkts};
+  if (count == 0u) {
+    return {};
+  }
+
+  return iterator{reinterpret_cast<const ::tpacket3_hdr *>(reinterpret_cast<std::byte *>(block_) +
+                                                          block_->hdr.bh1.offset_to_first_pkt),
+                  count};
+}
+
+void packet_block::release() noexcept {
+  if (block_ != nullptr) {
+    __atomic_store_n(&block_->hdr.bh1.block_status, TP_STATUS_KERNEL, __ATOMIC_RELEASE);
+    block_ = nullptr;
+  }
+}
+
+// packet_ring
+
+packet_ring::packet_ring(socket s, mmap map, const packet_ring_config &config,
+                         const uint16_t protocol) noexcept
+    : socket_{std::move(s)},
+      map_{std::move(map)},
+      block_size_{config.block_size},
+      block_count_{config.block_count},
+      protocol_{protocol} {}
+
+result<packet_ring> packet_ring::create(const packet_ring_config &config, const uint16_t protocol,
+                                        const socket_flag flags) noexcept {
+  const auto page_size{::sysconf(_SC_PAGESIZE)};
+  if (config.block_count == 0u or config.frame_size < TPACKET3_HDRLEN or
+      config.frame_size % TPACKET_ALIGNMENT != 0u or config.block_size < config.frame_size or
+      config.block_size % static_cast<std::size_t>(page_size) != 0u or
+      config.block_size > UINT32_MAX or config.block_count > UINT32_MAX or
+      config.block_timeout.count() < 0) {
+    return make_errno_code(std::errc::invalid_argument);
+  }
+
+  // Nothing is received until bind, so the ring cannot fill with frames of another protocol while
+  // it is being set up.
+  auto s{socket::unsafe_make(socket_domain::packet, socket_type::raw, flags,
+                             socket_protocol{0})};
+  if (not s) {
+    return s.error();
+  }
+
+  const int version{TPACKET_V3};
+  if (const auto error = s->unsafe_setsockopt(socket_level::packet, socket_option::packet_version,
+                                              any_cview{&version})) {
+    return error;
+  }
+
+  ::tpacket_req3 request{};
+  request.tp_block_size = static_cast<unsigned>(config.block_size);
+  request.tp_block_nr = static_cast<unsigned>(config.block_count);
+  request.tp_frame_size = static_cast<unsigned>(config.frame_size);
+  request.tp_frame_nr =
+      static_cast<unsigned>(config.block_size / config.frame_size * config.block_count);
+  request.tp_retire_blk_tov = static_cast<unsigned>(config.block_timeout.count());
+
+  if (const auto error = s->unsafe_setsockopt(socket_level::packet, socket_option::packet_rx_ring,
+                                              any_cview{&request})) {
+    return error;
+  }
+
+  auto map{mmap::map(nullptr, config.block_size * config.block_count, mmap_read | mmap_write,
+                     mmap_shared, raw_fd{static_cast<raw_fd_t>(s->fd())}, 0)};
+  if (not map) {
+    return map.error();
+  }
+
+  return packet_ring{std::move(s.value()), std::move(map.value()), config, protocol};
+}
+
+std::error_code packet_ring::bind(const unsigned interface_index) noexcept {
+  ::sockaddr_ll address{};
+  address.sll_family = AF_PACKET;
+  address.sll_protocol = detail::host_to_network(protocol_);
+  address.sll_ifindex = static_cast<int>(interface_index);
+
+  return socket_.unsafe_bind(reinterpret_cast<const ::sockaddr *>(&address), sizeof(address));
+}
+
+std::optional<packet_block> packet_ring::next() noexcept {
+  // A default constructed or moved from ring has nothing mapped.
+  if (map_.empty()) {
+    return std::nullopt;
+  }
+
+  auto *const block{reinterpret_cast<::tpacket_block_desc *>(
+      map_.bytes().data() + current_ * block_size_)};
+
+  if ((load_status(block) & TP_STATUS_USER) == 0u) {
+    return std::nullopt;
+  }
+
+  current_ = (current_ + 1u) % block_count_;
+  return packet_block{block};
+}
+
+result<packet_ring_stats> packet_ring::stats() noexcept {
+  ::tpacket_stats_v3 kernel_stats{};
+  const auto length = socket_.unsafe_getsockopt(socket_level::packet,
+                                                socket_option::packet_statistics,
+                                                any_view{&kernel_stats});
+  if (not length) {
+    return length.error();
+  }
+
+  return packet_ring_stats{kernel_stats.tp_packets, kernel_stats.tp_drops,
+                           kernel_stats.tp_freeze_q_cnt};
+}
+
+}  // namespace pposix::lnx
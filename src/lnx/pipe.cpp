@@ -0,0 +1,40 @@
+#include "pposix/lnx/pipe.hpp"
+
+#include <unistd.h>
+
+#include <climits>
+
+#include "pposix/errno.hpp"
+#include "pposix/fcntl.hpp"
+
+namespace pposix::lnx {
+
+pipe::pipe(const raw_fd read_fd, const raw_fd write_fd) noexcept
+    : read_fd_{read_fd}, write_fd_{write_fd} {}
+
+result<pipe> pipe::create(const pipe_flag flags) noexcept {
+  int fds[2];
+  if (::pipe2(fds, underlying_v(flags)) == -1) {
+    return current_errno_code();
+  }
+
+  return pipe{raw_fd{fds[0]}, raw_fd{fds[1]}};
+}
+
+result<std::size_t> pipe::capacity() const noexcept {
+  return result_map<std::size_t>(
+      capi::fcntl(write_fd(), capi::fcntl_cmd::getpipe_sz),
+      [](const int size) noexcept { return static_cast<std::size_t>(size); });
+}
+
+result<std::size_t> pipe::set_capacity(const std::size_t size) noexcept {
+  if (size > std::size_t{INT_MAX}) {
+    return make_errno_code(std::errc::invalid_argument);
+  }
+
+  return result_map<std::size_t>(
+      capi::fcntl(write_fd(), capi::fcntl_cmd::setpipe_sz, static_cast<int>(size)),
+      [](const int new_size) noexcept { return static_cast<std::size_t>(new_size); });
+}
+
+}  // namespace pposix::lnx
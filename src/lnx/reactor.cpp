@@ -0,0 +1,104 @@
+#include "pposix/lnx/reactor.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <new>
+#include <stdexcept>
+
+#include "pposix/errno.hpp"
+#include "pposix/util.hpp"
+
+namespace pposix::lnx {
+
+// Every condition in the event gets its callback. An error (e.g. a pending error queue message)
+// often arrives together with read readiness, which an edge-triggered registration reports once.
+void reactor_handler::on_event(const epoll_event &event) noexcept {
+  if (event.fd_error()) {
+    on_error();
+  }
+
+  if (event.read_available() or event.fd_exception()) {
+    on_read();
+  }
+
+  if (event.write_available()) {
+    on_write();
+  }
+
+  if (event.fd_hup() or event.socket_closed()) {
+    on_hup();
+  }
+}
+
+reactor::reactor(lnx::epoll ep, std::vector<epoll_event> events) noexcept
+    : epoll_{std::move(ep)}, events_{std::move(events)} {}
+
+result<reactor> reactor::create(const std::size_t max_events) noexcept {
+  if (max_events == 0u) {
+    return make_errno_code(std::errc::invalid_argument);
+  }
+
+  std::vector<epoll_event> events{};
+  try {
+    events.resize(max_events);
+  } catch (const std::bad_alloc &) {
+    return make_errno_code(std::errc::not_enough_memory);
+  } catch (const std::length_error &) {
+    return make_errno_code(std::errc::not_enough_memory);
+  }
+
+  auto ep{lnx::epoll::create(epoll_cloexec)};
+  if (not ep) {
+    return ep.error();
+  }
+
+  return reactor{std::move(ep.value()), std::move(events)};
+}
+
+std::error_code reactor::remove(const raw_fd fd) noexcept { return epoll_.ctl(epoll_remove{fd}); }
+
+result<int> reactor::wait(const milliseconds timeout) noexcept {
+  const span<epoll_event> events{events_.data(), events_.size()};
+  if (spin_.budget.count() <= 0 or timeout.count() == 0) {
+    return epoll_.wait(events, timeout);
+  }
+
+  // Never spin for longer than the caller is willing to wait.
+  const nanoseconds limit{timeout.count() < 0 ? spin_.budget
+                                              : std::min(spin_.budget, nanoseconds{timeout})};
+
+  const auto start{std::chrono::steady_clock::now()};
+  auto spent{nanoseconds{0}};
+  do {
+    const auto res{epoll_.wait(events, milliseconds{0})};
+    if (not res or *res > 0) {
+      return res;
+    }
+
+    spent = std::chrono::duration_cast<nanoseconds>(std::chrono::steady_clock::now() - start);
+  } while (spent < limit);
+
+  if (timeout.count() < 0) {
+    return epoll_.wait(events, timeout);
+  }
+
+  const auto spent_ms{std::chrono::duration_cast<milliseconds>(spent)};
+  return spent_ms >= timeout ? 0 : epoll_.wait(events, timeout - spent_ms);
+}
+
+result<int> reactor::run_once(const milliseconds timeout) noexcept {
+  const auto res{wait(timeout)};
+  if (not res) {
+    return res;
+  }
+
+  const int count{*res};
+  for (int i = 0; i < count; ++i) {
+    const epoll_event &event{events_[static_cast<std::size_t>(i)]};
+    static_cast<reactor_handler *>(event.data.ptr)->on_event(event);
+  }
+
+  return count;
+}
+
+}  // namespace pposix::lnx
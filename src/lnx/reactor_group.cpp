@@ -0,0 +1,209 @@
+#include "pposix/lnx/reactor_group.hpp"
+
+#include <pthread.h>
+#include <sched.h>
+
+#include <atomic>
+#include <new>
+#include <stdexcept>
+#include <thread>
+
+#include "pposix/errno.hpp"
+#include "pposix/util.hpp"
+
+namespace pposix::lnx {
+
+// One reactor and the thread that drives it. Tasks posted from other threads go through a
+// lock-free task_queue whose eventfd is registered with the shard's reactor.
+class reactor_shard final : public reactor_handler {
+ public:
+  reactor_shard(reactor r, task_queue tasks) noexcept
+      : reactor_{std::move(r)}, tasks_{std::move(tasks)} {}
+
+  ~reactor_shard() override { stop(); }
+
+  static result<std::unique_ptr<reactor_shard>> create(std::size_t max_events) noexcept {
+    auto r{reactor::create(max_events)};
+    if (not r) {
+      return r.error();
+    }
+
+    auto tasks{task_queue::create()};
+    if (not tasks) {
+      return tasks.error();
+    }
+
+    std::unique_ptr<reactor_shard> shard{
+        new (std::nothrow) reactor_shard{std::move(r.value()), std::move(tasks.value())}};
+    if (not shard) {
+      return make_errno_code(std::errc::not_enough_memory);
+    }
+
+    if (const auto error = shard->reactor_.add(shard->tasks_.fd(), epoll_read_available, *shard)) {
+      return error;
+    }
+
+    return shard;
+  }
+
+  reactor &get() noexcept { return reactor_; }
+
+  std::error_code post(reactor_task &task) noexcept { return tasks_.post(task); }
+
+  bool running() const noexcept { return running_; }
+
+  std::error_code start(const std::size_t cpu, const reactor_affinity affinity) noexcept {
+    if (running()) {
+      return make_errno_code(std::errc::device_or_resource_busy);
+    }
+
+    ::pthread_attr_t attr;
+    if (const int error{::pthread_attr_init(&attr)}; error != 0) {
+      return make_errno_code(std::errc{error});
+    }
+
+    // The affinity is set on the attributes rather than on the running thread, so a pinned shard
+    // never runs a single instruction on another CPU.
+    int error{0};
+    if (affinity == reactor_affinity::pin_to_cpu) {
+      ::cpu_set_t cpus;
+      CPU_ZERO(&cpus);
+      CPU_SET(cpu, &cpus);
+      error = ::pthread_attr_setaffinity_np(&attr, sizeof(cpus), &cpus);
+    }
+
+    stopping_.store(false, std::memory_order_relaxed);
+    if (error == 0) {
+      error = ::pthread_create(&thread_, &attr, &reactor_shard::thread_main, this);
+    }
+
+    (void)::pthread_attr_destroy(&attr);
+    if (error != 0) {
+      return make_errno_code(std::errc{error});
+    }
+
+    running_ = true;
+    return {};
+  }
+
+  void stop() noexcept {
+    if (not running()) {
+      return;
+    }
+
+    stopping_.store(true, std::memory_order_release);
+    (void)tasks_.wake();
+    (void)::pthread_join(thread_, nullptr);
+    running_ = false;
+  }
+
+  void on_read() noexcept override { (void)tasks_.run_pending(); }
+
+ private:
+  static void *thread_main(void *shard) noexcept {
+    static_cast<reactor_shard *>(shard)->run();
+    return nullptr;
+  }
+
+  void run() noexcept {
+    while (not stopping_.load(std::memory_order_acquire)) {
+      const auto res{reactor_.run_once(milliseconds{-1})};
+      if (not res and res.error() != std::errc::interrupted) {
+        break;
+      }
+    }
+  }
+
+  reactor reactor_;
+  task_queue tasks_;
+
+  std::atomic<bool> stopping_{false};
+  ::pthread_t thread_{};
+  bool running_{false};
+};
+
+reactor_group::reactor_group() noexcept = default;
+
+reactor_group::reactor_group(std::vector<std::unique_ptr<reactor_shard>> shards) noexcept
+    : shards_{std::move(shards)} {}
+
+reactor_group::~reactor_group() { stop(); }
+
+reactor_group::reactor_group(reactor_group &&) noexcept = default;
+
+reactor_group &reactor_group::operator=(reactor_group &&other) noexcept {
+  stop();
+  shards_ = std::move(other.shards_);
+  return *this;
+}
+
+result<reactor_group> reactor_group::create(const std::size_t shard_count,
+                                            const std::size_t max_events_per_shard) noexcept {
+  if (shard_count == 0u) {
+    return make_errno_code(std::errc::invalid_argument);
+  }
+
+  std::vector<std::unique_ptr<reactor_shard>> shards;
+  try {
+    shards.reserve(shard_count);
+  } catch (const std::bad_alloc &) {
+    return make_errno_code(std::errc::not_enough_memory);
+  } catch (const std::length_error &) {
+    return make_errno_code(std::errc::not_enough_memory);
+  }
+
+  for (std::size_t i = 0u; i < shard_count; ++i) {
+    auto shard{reactor_shard::create(max_events_per_shard)};
+    if (not shard) {
+      return shard.error();
+    }
+
+    shards.push_back(std::move(shard.value()));
+  }
+
+  return reactor_group{std::move(shards)};
+}
+
+result<reactor_group> reactor_group::create(const std::size_t max_events_per_shard) noexcept {
+  const unsigned hardware_threads{std::thread::hardware_concurrency()};
+  return create(hardware_threads == 0u ? 1u : hardware_threads, max_events_per_shard);
+}
+
+reactor &reactor_group::shard(const std::size_t index) noexcept { return shards_[index]->get(); }
+
+std::error_code reactor_group::post(const std::size_t shard_index, reactor_task &task) noexcept {
+  if (shard_index >= shards_.size()) {
+    return make_errno_code(std::errc::invalid_argument);
+  }
+
+  return shards_[shard_index]->post(task);
+}
+
+std::error_code reactor_group::start(const reactor_affinity affinity) noexcept {
+  // Checked up front so a second start fails without stopping the running shards.
+  for (const auto &shard : shards_) {
+    if (shard->running()) {
+      return make_errno_code(std::errc::device_or_resource_busy);
+    }
+  }
+
+  const unsigned hardware_threads{std::thread::hardware_concurrency()};
+
+  for (std::size_t i = 0u; i < shards_.size(); ++i) {
+    const std::size_t cpu{hardware_threads == 0u ? 0u : i % hardware_threads};
+    if (const auto error = shards_[i]->start(cpu, affinity)) {
+      stop();
+      return error;
+    }
+  }
+
+  return {};
+}
+
+void reactor_group::stop() noexcept {
+  for (auto &shard : shards_) {
+    shard->stop();
+  }
+}
+
+}  // namespace pposix::lnx
@@ -0,0 +1,88 @@
+#include "pposix/lnx/reuseport_group.hpp"
+
+#include <linux/filter.h>
+
+#include <limits>
+#include <new>
+#include <stdexcept>
+
+#include "pposix/errno.hpp"
+
+namespace pposix::lnx {
+
+reuseport_group::reuseport_group(std::vector<socket> sockets) noexcept
+    : sockets_{std::move(sockets)} {}
+
+result<reuseport_group> reuseport_group::unsafe_create(
+    const socket_domain domain, const socket_type type, const socket_flag flags,
+    const ::sockaddr *const address, const socklen_t length, const std::size_t count,
+    const int backlog) noexcept {
+  if (count == 0u or count > std::numeric_limits<uint32_t>::max()) {
+    return make_errno_code(std::errc::invalid_argument);
+  }
+
+  // Reserved up front so the push_back calls below cannot throw.
+  std::vector<socket> sockets;
+  try {
+    sockets.reserve(count);
+  } catch (const std::bad_alloc &) {
+    return make_errno_code(std::errc::not_enough_memory);
+  } catch (const std::length_error &) {
+    return make_errno_code(std::errc::not_enough_memory);
+  }
+
+  // The rest of the group binds to the address the first socket got, so binding to port 0 picks
+  // one ephemeral port for the whole group instead of one per socket.
+  socket_address bound{};
+
+  // Sockets join the group in bind order, which is the index the program selects them by.
+  for (std::size_t i = 0u; i < count; ++i) {
+    auto s{socket::unsafe_make(domain, type, flags, socket_protocol::ip)};
+    if (not s) {
+      return s.error();
+    }
+
+    if (const auto error = s->setsockopt(socket_level::socket, socket_reuseport::on)) {
+      return error;
+    }
+
+    if (const auto error = i == 0u ? s->unsafe_bind(address, length)
+                                   : s->unsafe_bind(bound.data(), bound.length())) {
+      return error;
+    }
+
+    if (i == 0u) {
+      auto local{s->local_address()};
+      if (not local) {
+        return local.error();
+      }
+
+      bound = *local;
+    }
+
+    if (type == socket_type::stream or type == socket_type::seqpacket) {
+      if (const auto error = s->listen(backlog)) {
+        return error;
+      }
+    }
+
+    sockets.push_back(std::move(s.value()));
+  }
+
+  // A = cpu; A %= count; return A
+  const ::sock_filter program[]{
+      {BPF_LD | BPF_W | BPF_ABS, 0, 0, static_cast<uint32_t>(SKF_AD_OFF + SKF_AD_CPU)},
+      {BPF_ALU | BPF_MOD | BPF_K, 0, 0, static_cast<uint32_t>(count)},
+      {BPF_RET | BPF_A, 0, 0, 0},
+  };
+
+  // The program applies to the whole group, whichever socket it is attached to.
+  if (const auto error = sockets.front().setsockopt(socket_level::socket,
+                                                    socket_reuseport_cbpf{program})) {
+    return error;
+  }
+
+  return reuseport_group{std::move(sockets)};
+}
+
+}  // namespace pposix::lnx
@@ -0,0 +1,34 @@
+#include "pposix/lnx/signalfd.hpp"
+
+#include <unistd.h>
+
+#include "pposix/errno.hpp"
+
+namespace pposix::lnx {
+
+signalfd::signalfd(const raw_fd fd) noexcept : fd_{fd} {}
+
+result<signalfd> signalfd::unsafe_create(const sigset &signals,
+                                         const capi::signalfd_flag flags) noexcept {
+  if (const auto fd{::signalfd(-1, signals.sigset_ptr(), underlying_v(flags))}; fd == -1) {
+    return current_errno_code();
+  } else {
+    return signalfd{raw_fd{fd}};
+  }
+}
+
+std::error_code signalfd::set_mask(const sigset &signals) noexcept {
+  return PPOSIX_COMMON_CALL(::signalfd, static_cast<raw_fd_t>(*fd_), signals.sigset_ptr(), 0);
+}
+
+result<std::size_t> signalfd::read(span<signalfd_info> infos) noexcept {
+  const auto bytes{::read(static_cast<raw_fd_t>(*fd_), infos.data(),
+                            infos.length() * sizeof(signalfd_info))};
+  if (bytes == -1) {
+    return current_errno_code();
+  } else {
+    return static_cast<std::size_t>(bytes) / sizeof(signalfd_info);
+  }
+}
+
+}  // namespace pposix::lnx
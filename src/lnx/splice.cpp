@@ -0,0 +1,165 @@
+#include "pposix/lnx/splice.hpp"
+
+#include <sys/sendfile.h>
+#include <unistd.h>
+
+#include <utility>
+
+#include "pposix/errno.hpp"
+#include "pposix/uio.hpp"
+
+namespace pposix::lnx {
+
+namespace {
+
+raw_fd socket_raw_fd(const socket &s) noexcept { return raw_fd{static_cast<raw_fd_t>(s.fd())}; }
+
+result<std::size_t> byte_count(const ssize_t count) noexcept {
+  if (count == -1) {
+    return current_errno_code();
+  } else {
+    return static_cast<std::size_t>(count);
+  }
+}
+
+// Repeat a single transfer step until count bytes are moved, the step returns zero or it fails. A
+// failure is only reported if nothing was moved.
+template <class Step>
+result<std::size_t> transfer_all(const std::size_t count, Step &&step) noexcept {
+  std::size_t moved{0u};
+  while (moved < count) {
+    const auto res{step(count - moved)};
+    if (not res) {
+      if (moved > 0u) {
+        break;
+      }
+
+      return res.error();
+    }
+
+    if (*res == 0u) {
+      break;
+    }
+
+    moved += *res;
+  }
+
+  return moved;
+}
+
+}  // namespace
+
+result<std::size_t> sendfile(socket &out, const file &in, off_t &offset,
+                             const std::size_t count) noexcept {
+  return byte_count(::sendfile(static_cast<raw_fd_t>(socket_raw_fd(out)),
+                               static_cast<raw_fd_t>(in.fd()), &offset, count));
+}
+
+result<std::size_t> splice(const raw_fd in, loff_t *const in_offset, const raw_fd out,
+                           loff_t *const out_offset, const std::size_t count,
+                           const splice_flag flags) noexcept {
+  return byte_count(::splice(static_cast<raw_fd_t>(in), in_offset, static_cast<raw_fd_t>(out),
+                             out_offset, count, underlying_v(flags)));
+}
+
+result<std::size_t> tee(const pipe &in, const pipe &out, const std::size_t count,
+                        const splice_flag flags) noexcept {
+  return byte_count(::tee(static_cast<raw_fd_t>(in.read_fd()),
+                          static_cast<raw_fd_t>(out.write_fd()), count, underlying_v(flags)));
+}
+
+result<std::size_t> vmsplice(const pipe &out, const cspan<byte_cspan> buffers,
+                             const splice_flag flags) noexcept {
+  return byte_count(::vmsplice(static_cast<raw_fd_t>(out.write_fd()),
+                               pposix::detail::as_iovec(buffers), buffers.length(),
+                               underlying_v(flags)));
+}
+
+splice_relay::splice_relay(pipe p) noexcept : pipe_{std::move(p)} {}
+
+result<splice_relay> splice_relay::create(const std::size_t capacity) noexcept {
+  auto p{pipe::create(pipe_flag::cloexec | pipe_flag::nonblock)};
+  if (not p) {
+    return p.error();
+  }
+
+  if (capacity != 0u) {
+    if (const auto res{p->set_capacity(capacity)}; not res) {
+      return res.error();
+    }
+  }
+
+  return splice_relay{std::move(p.value())};
+}
+
+result<std::size_t> splice_relay::transfer(const raw_fd out, const raw_fd in,
+                                           const std::size_t count) noexcept {
+  constexpr splice_flag flags{splice_flag::move | splice_flag::nonblock};
+
+  return transfer_all(count, [&](const std::size_t left) noexcept -> result<std::size_t> {
+    if (buffered_ == 0u) {
+      const auto filled{splice(in, nullptr, pipe_.write_fd(), nullptr, left, flags)};
+      if (not filled or *filled == 0u) {
+        return filled;
+      }
+
+      buffered_ = *filled;
+    }
+
+    // Drain what is buffered even if it is more than left, which only happens when the previous
+    // call stopped with bytes in the pipe.
+    const auto drained{splice(pipe_.read_fd(), nullptr, out, nullptr, buffered_, flags)};
+    if (drained) {
+      buffered_ -= *drained;
+    }
+
+    return drained;
+  });
+}
+
+result<std::size_t> transfer(socket &out, const file &in, off_t &offset,
+                             const std::size_t count) noexcept {
+  return transfer_all(count, [&](const std::size_t left) noexcept {
+    return sendfile(out, in, offset, left);
+  });
+}
+
+result<std::size_t> transfer(file &out, const file &in, off_t &offset,
+                             const std::size_t count) noexcept {
+  bool use_sendfile{false};
+
+  return transfer_all(count, [&](const std::size_t left) noexcept -> result<std::size_t> {
+    if (not use_sendfile) {
+      loff_t in_offset{offset};
+      const auto res{byte_count(::copy_file_range(static_cast<raw_fd_t>(in.fd()), &in_offset,
+                                                  static_cast<raw_fd_t>(out.fd()), nullptr, left,
+                                                  0u))};
+      offset = static_cast<off_t>(in_offset);
+
+      // Copies between filesystems (EXDEV) or on filesystems and kernels without support fall
+      // back to sendfile, which also moves the data in the kernel, through the page cache.
+      if (res or (res.error() != std::errc::cross_device_link and
+                  res.error() != std::errc::operation_not_supported and
+                  res.error() != std::errc::function_not_supported)) {
+        return res;
+      }
+
+      use_sendfile = true;
+    }
+
+    return byte_count(::sendfile(static_cast<raw_fd_t>(out.fd()), static_cast<raw_fd_t>(in.fd()),
+                                 &offset, left));
+  });
+}
+
+result<std::size_t> transfer(socket &out, socket &in, splice_relay &relay,
+                             const std::size_t count) noexcept {
+  return relay.transfer(socket_raw_fd(out), socket_raw_fd(in), count);
+}
+
+result<std::size_t> transfer(file &out, socket &in, splice_relay &relay,
+                             const std::size_t count) noexcept {
+  return relay.transfer(out.fd(), socket_raw_fd(in), count);
+}
+
+}  // namespace pposix::lnx
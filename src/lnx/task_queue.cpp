@@ -0,0 +1,85 @@
+#include "pposix/lnx/task_queue.hpp"
+
+#include "pposix/errno.hpp"
+
+namespace pposix::lnx {
+
+task_queue::task_queue(lnx::eventfd event) noexcept : event_{std::move(event)} {}
+
+task_queue::task_queue(task_queue &&other) noexcept
+    : event_{std::move(other.event_)},
+      head_{other.head_.exchange(nullptr, std::memory_order_acquire)},
+      signalled_{other.signalled_.exchange(false, std::memory_order_relaxed)} {}
+
+task_queue &task_queue::operator=(task_queue &&other) noexcept {
+  event_ = std::move(other.event_);
+  head_.store(other.head_.exchange(nullptr, std::memory_order_acquire), std::memory_order_release);
+  signalled_.store(other.signalled_.exchange(false, std::memory_order_relaxed),
+                   std::memory_order_relaxed);
+  return *this;
+}
+
+result<task_queue> task_queue::create() noexcept {
+  auto event{lnx::eventfd::create(0u, eventfd_cloexec | eventfd_nonblock)};
+  if (not event) {
+    return event.error();
+  }
+
+  return task_queue{std::move(event.value())};
+}
+
+std::error_code task_queue::post(reactor_task &task) noexcept {
+  reactor_task *head{head_.load(std::memory_order_relaxed)};
+  do {
+    task.next_ = head;
+  } while (not head_.compare_exchange_weak(head, &task, std::memory_order_release,
+                                           std::memory_order_relaxed));
+
+  // Whoever flips the flag is responsible for the wakeup; everyone else piggybacks on it until the
+  // consumer clears the flag again.
+  if (signalled_.exchange(true, std::memory_order_acq_rel)) {
+    return {};
+  }
+
+  return event_.write(1u);
+}
+
+std::error_code task_queue::wake() noexcept {
+  signalled_.store(true, std::memory_order_release);
+  return event_.write(1u);
+}
+
+result<std::size_t> task_queue::run_pending() noexcept {
+  if (const auto res{event_.read()};
+      not res and res.error() != std::errc::resource_unavailable_try_again) {
+    return res.error();
+  }
+
+  // Clear the flag before taking the tasks: a post that misses this batch is then guaranteed to
+  // see the flag cleared and signal the eventfd again.
+  (void)signalled_.exchange(false, std::memory_order_acq_rel);
+
+  reactor_task *task{head_.exchange(nullptr, std::memory_order_acquire)};
+
+  // The stack is newest first; reverse it so tasks run in the order they were posted.
+  reactor_task *ordered{nullptr};
+  while (task != nullptr) {
+    reactor_task *const next{task->next_};
+    task->next_ = ordered;
+    ordered = task;
+    task = next;
+  }
+
+  std::size_t count{0u};
+  while (ordered != nullptr) {
+    // A task may post itself again from run(), so read the link first.
+    reactor_task *const next{ordered->next_};
+    ordered->run();
+    ordered = next;
+    ++count;
+  }
+
+  return count;
+}
+
+}  // namespace pposix::lnx
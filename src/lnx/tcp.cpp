@@ -0,0 +1,39 @@
+#include "pposix/lnx/tcp.hpp"
+
+#include <utility>
+
+namespace pposix::lnx {
+
+tcp_cork_batch::tcp_cork_batch(socket &s) noexcept : socket_{&s} {}
+
+tcp_cork_batch::tcp_cork_batch(tcp_cork_batch &&other) noexcept
+    : socket_{std::exchange(other.socket_, nullptr)} {}
+
+tcp_cork_batch &tcp_cork_batch::operator=(tcp_cork_batch &&other) noexcept {
+  if (this != &other) {
+    (void)uncork();
+    socket_ = std::exchange(other.socket_, nullptr);
+  }
+
+  return *this;
+}
+
+tcp_cork_batch::~tcp_cork_batch() { (void)uncork(); }
+
+result<tcp_cork_batch> tcp_cork_batch::create(socket &s) noexcept {
+  if (const auto error = s.setsockopt(socket_level::tcp, socket_tcp_cork::on)) {
+    return error;
+  }
+
+  return tcp_cork_batch{s};
+}
+
+std::error_code tcp_cork_batch::uncork() noexcept {
+  if (socket_ == nullptr) {
+    return {};
+  }
+
+  return std::exchange(socket_, nullptr)->setsockopt(socket_level::tcp, socket_tcp_cork::off);
+}
+
+}  // namespace pposix::lnx
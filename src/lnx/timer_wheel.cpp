@@ -0,0 +1,289 @@
+#include "pposix/lnx/timer_wheel.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <new>
+
+#include "pposix/errno.hpp"
+#include "pposix/lnx/epoll.hpp"
+#include "pposix/lnx/timerfd.hpp"
+
+namespace pposix::lnx {
+
+namespace detail {
+
+class timer_wheel_state final : public reactor_handler {
+  static constexpr std::size_t level_bits{8u};
+  static constexpr std::size_t level_count{4u};
+  static constexpr std::size_t slot_count{std::size_t{1u} << level_bits};
+  static constexpr uint64_t slot_mask{slot_count - 1u};
+
+  // Timers further out than this are parked in the last level and re-placed when it cascades.
+  static constexpr uint64_t max_delta{(uint64_t{1u} << (level_bits * level_count)) - 1u};
+
+ public:
+  timer_wheel_state(timerfd fd, const nanoseconds tick) noexcept
+      : timerfd_{std::move(fd)}, tick_{tick} {}
+
+  ~timer_wheel_state() override {
+    for (timer *&head : slots_) {
+      while (head != nullptr) {
+        unlink(*head);
+      }
+    }
+  }
+
+  std::error_code schedule(timer &t, const nanoseconds delay) noexcept {
+    if (t.wheel_ != nullptr) {
+      t.wheel_->cancel(t);
+    }
+
+    const auto now{std::chrono::steady_clock::now()};
+    if (not armed_) {
+      if (const auto error = timerfd_.set(tick_, tick_)) {
+        return error;
+      }
+
+      armed_ = true;
+      armed_at_ = now;
+      armed_tick_ = now_;
+    }
+
+    // Tick armed_tick_ + n is processed when the timerfd fires for the (n + 1)th time, so the
+    // expiry is derived from the time since arming rather than from now_, which lags behind by any
+    // expirations that have not been read yet.
+    const auto since_armed{std::chrono::duration_cast<nanoseconds>(now - armed_at_) +
+                           std::max(delay, nanoseconds{0})};
+    const auto ticks{std::max((since_armed.count() + tick_.count() - 1) / tick_.count(), 1L)};
+    t.expiry_ = std::max(now_, armed_tick_ + static_cast<uint64_t>(ticks) - 1u);
+
+    t.wheel_ = this;
+    place(t);
+    ++size_;
+
+    return {};
+  }
+
+  void cancel(timer &t) noexcept {
+    if (t.wheel_ != this) {
+      return;
+    }
+
+    // The timerfd is left running; it is disarmed once it fires with nothing scheduled.
+    unlink(t);
+    --size_;
+  }
+
+  std::size_t size() const noexcept { return size_; }
+
+  nanoseconds tick() const noexcept { return tick_; }
+
+  raw_fd fd() const noexcept { return timerfd_.fd(); }
+
+  result<std::size_t> expire() noexcept {
+    const auto expirations{timerfd_.read()};
+    if (not expirations) {
+      if (expirations.error() == std::errc::resource_unavailable_try_again) {
+        return std::size_t{0u};
+      }
+
+      return expirations.error();
+    }
+
+    const std::size_t fired{advance(*expirations)};
+
+    if (size_ == 0u and armed_) {
+      if (const auto error = timerfd_.disarm()) {
+        return error;
+      }
+
+      armed_ = false;
+    }
+
+    return fired;
+  }
+
+  void on_read() noexcept override { (void)expire(); }
+
+ private:
+  timer *&slot(const std::size_t level, const std::size_t index) noexcept {
+    return slots_[level * slot_count + index];
+  }
+
+  static void link(timer *&head, timer &t) noexcept {
+    t.next_ = head;
+    if (head != nullptr) {
+      head->pprev_ = &t.next_;
+    }
+
+    head = &t;
+    t.pprev_ = &head;
+  }
+
+  static void unlink(timer &t) noexcept {
+    *t.pprev_ = t.next_;
+    if (t.next_ != nullptr) {
+      t.next_->pprev_ = t.pprev_;
+    }
+
+    t.next_ = nullptr;
+    t.pprev_ = nullptr;
+    t.wheel_ = nullptr;
+  }
+
+  void place(timer &t) noexcept {
+    uint64_t delta{t.expiry_ - now_};
+    uint64_t expiry{t.expiry_};
+    if (delta > max_delta) {
+      delta = max_delta;
+      expiry = now_ + max_delta;
+    }
+
+    std::size_t level{0u};
+    while (level + 1u < level_count and delta >= (uint64_t{1u} << (level_bits * (level + 1u)))) {
+      ++level;
+    }
+
+    link(slot(level, (expiry >> (level_bits * level)) & slot_mask), t);
+  }
+
+  // Move every timer in the current slot of the given level down to the finer levels.
+  void cascade(const std::size_t level) noexcept {
+    timer *&head{slot(level, (now_ >> (level_bits * level)) & slot_mask)};
+    timer *pending{head};
+    head = nullptr;
+
+    while (pending != nullptr) {
+      timer &t{*pending};
+      pending = t.next_;
+      place(t);
+    }
+  }
+
+  std::size_t advance(uint64_t ticks) noexcept {
+    std::size_t fired{0u};
+
+    for (; ticks > 0u; --ticks) {
+      if (size_ == 0u) {
+        now_ += ticks;
+        break;
+      }
+
+      const std::size_t index{now_ & slot_mask};
+      if (index == 0u) {
+        for (std::size_t level = 1u; level < level_count; ++level) {
+          cascade(level);
+          if (((now_ >> (level_bits * level)) & slot_mask) != 0u) {
+            break;
+          }
+        }
+      }
+
+      // Expire one timer at a time so callbacks can safely cancel or reschedule other timers.
+      timer *&head{slot(0u, index)};
+      while (head != nullptr) {
+        timer &t{*head};
+        unlink(t);
+        --size_;
+        t.on_expire();
+        ++fired;
+      }
+
+      ++now_;
+    }
+
+    return fired;
+  }
+
+  timerfd timerfd_;
+  nanoseconds tick_;
+
+  bool armed_{false};
+  std::chrono::steady_clock::time_point armed_at_{};
+  uint64_t armed_tick_{0u};
+
+  // The tick that will be processed next.
+  uint64_t now_{0u};
+  std::size_t size_{0u};
+
+  timer *slots_[level_count * slot_count]{};
+};
+
+}  // namespace detail
+
+timer::~timer() {
+  if (wheel_ != nullptr) {
+    wheel_->cancel(*this);
+  }
+}
+
+timer_wheel::timer_wheel() noexcept = default;
+
+timer_wheel::timer_wheel(std::unique_ptr<detail::timer_wheel_state> state) noexcept
+    : state_{std::move(state)} {}
+
+timer_wheel::~timer_wheel() = default;
+
+timer_wheel::timer_wheel(timer_wheel &&) noexcept = default;
+
+timer_wheel &timer_wheel::operator=(timer_wheel &&) noexcept = default;
+
+result<timer_wheel> timer_wheel::create(const nanoseconds tick) noexcept {
+  if (tick.count() <= 0) {
+    return make_errno_code(std::errc::invalid_argument);
+  }
+
+  auto fd{timerfd::create(capi::timerfd_clock::monotonic, timerfd_cloexec | timerfd_nonblock)};
+  if (not fd) {
+    return fd.error();
+  }
+
+  std::unique_ptr<detail::timer_wheel_state> state{
+      new (std::nothrow) detail::timer_wheel_state{std::move(fd.value()), tick}};
+  if (not state) {
+    return make_errno_code(std::errc::not_enough_memory);
+  }
+
+  return timer_wheel{std::move(state)};
+}
+
+std::error_code timer_wheel::schedule(timer &t, const nanoseconds delay) noexcept {
+  if (empty()) {
+    return make_errno_code(std::errc::invalid_argument);
+  }
+
+  return state_->schedule(t, delay);
+}
+
+std::error_code timer_wheel::cancel(timer &t) noexcept {
+  if (empty()) {
+    return make_errno_code(std::errc::invalid_argument);
+  }
+
+  state_->cancel(t);
+  return {};
+}
+
+std::size_t timer_wheel::size() const noexcept { return empty() ? 0u : state_->size(); }
+
+nanoseconds timer_wheel::tick() const noexcept { return state_->tick(); }
+
+raw_fd timer_wheel::fd() const noexcept { return state_->fd(); }
+
+result<std::size_t> timer_wheel::expire() noexcept {
+  if (empty()) {
+    return make_errno_code(std::errc::invalid_argument);
+  }
+
+  return state_->expire();
+}
+
+std::error_code timer_wheel::attach(reactor &r) noexcept {
+  if (empty()) {
+    return make_errno_code(std::errc::invalid_argument);
+  }
+
+  return r.add(fd(), epoll_read_available, *state_);
+}
+
+}  // namespace pposix::lnx
@@ -0,0 +1,67 @@
+#include "pposix/lnx/timerfd.hpp"
+
+#include <unistd.h>
+
+#include "pposix/errno.hpp"
+#include "pposix/util.hpp"
+
+namespace pposix::lnx {
+
+namespace {
+
+::timespec to_timespec(const nanoseconds ns) noexcept {
+  constexpr long nanoseconds_per_second{1'000'000'000L};
+
+  ::timespec ts{};
+  ts.tv_sec = static_cast<time_t>(ns.count() / nanoseconds_per_second);
+  ts.tv_nsec = ns.count() % nanoseconds_per_second;
+  return ts;
+}
+
+nanoseconds from_timespec(const ::timespec &ts) noexcept {
+  return std::chrono::duration_cast<nanoseconds>(std::chrono::seconds{ts.tv_sec}) +
+         nanoseconds{ts.tv_nsec};
+}
+
+}  // namespace
+
+timerfd::timerfd(const raw_fd fd) noexcept : fd_{fd} {}
+
+result<timerfd> timerfd::unsafe_create(const capi::timerfd_clock clock,
+                                       const capi::timerfd_flag flags) noexcept {
+  if (const auto fd{::timerfd_create(underlying_v(clock), underlying_v(flags))}; fd == -1) {
+    return current_errno_code();
+  } else {
+    return timerfd{raw_fd{fd}};
+  }
+}
+
+std::error_code timerfd::set(const nanoseconds initial, const nanoseconds interval) noexcept {
+  ::itimerspec spec{};
+  spec.it_value = to_timespec(initial);
+  spec.it_interval = to_timespec(interval);
+
+  return PPOSIX_COMMON_CALL(::timerfd_settime, static_cast<raw_fd_t>(*fd_), 0, &spec, nullptr);
+}
+
+std::error_code timerfd::disarm() noexcept { return set(nanoseconds{0}, nanoseconds{0}); }
+
+result<nanoseconds> timerfd::remaining() const noexcept {
+  ::itimerspec spec{};
+  if (::timerfd_gettime(static_cast<raw_fd_t>(*fd_), &spec) == -1) {
+    return current_errno_code();
+  } else {
+    return from_timespec(spec.it_value);
+  }
+}
+
+result<uint64_t> timerfd::read() noexcept {
+  uint64_t expirations{};
+  if (::read(static_cast<raw_fd_t>(*fd_), &expirations, sizeof(expirations)) == -1) {
+    return current_errno_code();
+  } else {
+    return expirations;
+  }
+}
+
+}  // namespace pposix::lnx
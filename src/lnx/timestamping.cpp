@@ -0,0 +1,98 @@
+#include "pposix/lnx/timestamping.hpp"
+
+#include <netinet/in.h>
+
+#include "pposix/errno.hpp"
+
+namespace pposix::lnx {
+
+namespace {
+
+constexpr bool is_zero(const ::timespec &t) noexcept { return t.tv_sec == 0 and t.tv_nsec == 0; }
+
+pposix::timespec to_timespec(const ::timespec &t) noexcept {
+  pposix::timespec result{};
+  static_cast<::timespec &>(result) = t;
+  return result;
+}
+
+}  // namespace
+
+packet_timestamps rx_timestamps(const cmsg_range control) noexcept {
+  packet_timestamps timestamps{};
+
+  for (const cmsg c : control) {
+    if (c.level() != socket_level::socket) {
+      continue;
+    }
+
+    if (c.type() == SCM_TIMESTAMPNS) {
+      timestamps.software = to_timespec(c.value<::timespec>());
+    } else if (c.type() == SCM_TIMESTAMPING) {
+      // ts[0] is the software stamp and ts[2] the raw hardware stamp; ts[1] is no longer used.
+      // Unavailable stamps are zero.
+      const auto stamps{c.value<::scm_timestamping>()};
+      if (not is_zero(stamps.ts[0])) {
+        timestamps.software = to_timespec(stamps.ts[0]);
+      }
+
+      if (not is_zero(stamps.ts[2])) {
+        timestamps.hardware = to_timespec(stamps.ts[2]);
+      }
+    }
+  }
+
+  return timestamps;
+}
+
+result<std::size_t> read_tx_timestamps(socket &s, span<tx_timestamp> timestamps,
+                                       tx_timestamp_skipped &skipped) noexcept {
+  std::size_t count{0u};
+
+  while (count < timestamps.length()) {
+    alignas(::cmsghdr) std::byte control[cmsg_space(sizeof(::scm_timestamping)) +
+                                         cmsg_space(sizeof(::sock_extended_err) +
+                                                    sizeof(::sockaddr_in6))];
+
+    const auto message{
+        s.recvmsg(span<byte_span>{}, control, message_flag::errqueue | message_flag::dontwait)};
+    if (not message) {
+      if (message.error() == std::errc::resource_unavailable_try_again) {
+        break;
+      }
+
+      return message.error();
+    }
+
+    // Each message carries the stamps and an extended error saying which send they belong to.
+    std::optional<::scm_timestamping> stamps{};
+    std::optional<::sock_extended_err> error{};
+    for (const cmsg c : message->control()) {
+      if (c.level() == socket_level::socket and c.type() == SCM_TIMESTAMPING) {
+        stamps = c.value<::scm_timestamping>();
+      } else if ((c.level() == socket_level::ip and c.type() == IP_RECVERR) or
+                 (c.level() == socket_level::ipv6 and c.type() == IPV6_RECVERR)) {
+        error = c.value<::sock_extended_err>();
+      }
+    }
+
+    if (not stamps or not error or error->ee_origin != SO_EE_ORIGIN_TIMESTAMPING) {
+      // Zero copy completions carry no errno.
+      if (error and error->ee_origin != SO_EE_ORIGIN_ZEROCOPY and error->ee_errno != 0) {
+        skipped.last_error = make_errno_code(std::errc{static_cast<int>(error->ee_errno)});
+      }
+
+      ++skipped.count;
+      continue;
+    }
+
+    const bool hardware{is_zero(stamps->ts[0])};
+    timestamps.data()[count++] =
+        tx_timestamp{tx_timestamp_type{error->ee_info}, error->ee_data,
+                     to_timespec(hardware ? stamps->ts[2] : stamps->ts[0]), hardware};
+  }
+
+  return count;
+}
+
+}  // namespace pposix::lnx
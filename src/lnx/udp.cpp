@@ -0,0 +1,41 @@
+#include "pposix/lnx/udp.hpp"
+
+#include <netinet/udp.h>
+
+namespace pposix::lnx {
+
+result<ssize_t> send_segmented(socket &s, const cspan<byte_cspan> buffers,
+                               const uint16_t segment_size, const message_flag flags) noexcept {
+  alignas(::cmsghdr) std::byte control[cmsg_space(sizeof(uint16_t))];
+
+  cmsg_writer writer{control};
+  if (const auto error = writer.add(socket_level::udp, UDP_SEGMENT, segment_size)) {
+    return error;
+  }
+
+  return s.sendmsg(buffers, writer.data(), flags);
+}
+
+udp_segments gro_segments(const byte_cspan data, const cmsg_range control) noexcept {
+  for (const cmsg c : control) {
+    if (c.level() == socket_level::udp and c.type() == UDP_GRO) {
+      return udp_segments{data, static_cast<std::size_t>(c.value<int>())};
+    }
+  }
+
+  return udp_segments{data, 0u};
+}
+
+result<udp_segments> recv_coalesced(socket &s, byte_span buffer,
+                                    const message_flag flags) noexcept {
+  alignas(::cmsghdr) std::byte control[cmsg_space(sizeof(int))];
+
+  const auto message{s.recvmsg(span<byte_span>{&buffer, 1u}, control, flags)};
+  if (not message) {
+    return message.error();
+  }
+
+  return gro_segments(byte_cspan{buffer.data(), message->bytes()}, message->control());
+}
+
+}  // namespace pposix::lnx
@@ -0,0 +1,196 @@
+#include "pposix/lnx/xdp_socket.hpp"
+
+#include <sys/socket.h>
+
+#include <utility>
+
+#include "pposix/errno.hpp"
+
+namespace pposix::lnx {
+
+namespace {
+
+constexpr bool valid_ring_size(const uint32_t size) noexcept {
+  return size != 0u and (size & (size - 1u)) == 0u;
+}
+
+std::error_code set_ring_size(socket &s, const socket_option ring, const uint32_t size) noexcept {
+  const int entries{static_cast<int>(size)};
+  return s.unsafe_setsockopt(socket_level::xdp, ring, any_cview{&entries});
+}
+
+result<mmap> map_ring(const socket &s, const ::xdp_ring_offset &offsets, const uint32_t size,
+                      const std::size_t desc_size, const off_t page_offset) noexcept {
+  return mmap::map(nullptr, offsets.desc + size * desc_size, mmap_read | mmap_write, mmap_shared,
+                   raw_fd{static_cast<raw_fd_t>(s.fd())}, page_offset);
+}
+
+// The socket-level wakeups report these when the kernel is merely busy.
+std::error_code ignore_busy(const ssize_t res) noexcept {
+  if (res != -1) {
+    return {};
+  }
+
+  const auto error{current_errno_code()};
+  if (error == std::errc::resource_unavailable_try_again or
+      error == std::errc::device_or_resource_busy or error == std::errc::no_buffer_space or
+      error == std::errc::network_down) {
+    return {};
+  }
+
+  return error;
+}
+
+}  // namespace
+
+xdp_socket::xdp_socket(mmap umem, socket s, const xdp_socket_config &config) noexcept
+    : umem_{std::move(umem)},
+      socket_{std::move(s)},
+      frame_size_{config.frame_size},
+      frame_count_{config.frame_count} {}
+
+result<xdp_socket> xdp_socket::create(const xdp_socket_config &config,
+                                      const socket_flag flags) noexcept {
+  if (config.frame_count == 0u or not valid_ring_size(config.fill_size) or
+      not valid_ring_size(config.completion_size) or
+      (config.rx_size != 0u and not valid_ring_size(config.rx_size)) or
+      (config.tx_size != 0u and not valid_ring_size(config.tx_size)) or
+      (config.rx_size == 0u and config.tx_size == 0u)) {
+    return make_errno_code(std::errc::invalid_argument);
+  }
+
+  auto umem{mmap::map(nullptr, std::size_t{config.frame_count} * config.frame_size,
+                      mmap_read | mmap_write, mmap_private | mmap_anonymous, raw_fd{-1}, 0)};
+  if (not umem) {
+    return umem.error();
+  }
+
+  xdp_socket xsk{std::move(umem.value()), socket{}, config};
+
+  auto s{socket::unsafe_make(socket_domain::xdp, socket_type::raw, flags, socket_protocol{0})};
+  if (not s) {
+    return s.error();
+  }
+
+  xsk.socket_ = std::move(s.value());
+
+  ::xdp_umem_reg registration{};
+  registration.addr = reinterpret_cast<uint64_t>(xsk.umem_.data());
+  registration.len = xsk.umem_.length();
+  registration.chunk_size = config.frame_size;
+  registration.headroom = config.frame_headroom;
+
+  if (const auto error = xsk.socket_.unsafe_setsockopt(
+          socket_level::xdp, socket_option::xdp_umem_reg, any_cview{&registration})) {
+    return error;
+  }
+
+  if (const auto error = set_ring_size(xsk.socket_, socket_option::xdp_umem_fill_ring,
+                                       config.fill_size)) {
+    return error;
+  }
+
+  if (const auto error = set_ring_size(xsk.socket_, socket_option::xdp_umem_completion_ring,
+                                       config.completion_size)) {
+    return error;
+  }
+
+  if (config.rx_size != 0u) {
+    if (const auto error =
+            set_ring_size(xsk.socket_, socket_option::xdp_rx_ring, config.rx_size)) {
+      return error;
+    }
+  }
+
+  if (config.tx_size != 0u) {
+    if (const auto error =
+            set_ring_size(xsk.socket_, socket_option::xdp_tx_ring, config.tx_size)) {
+      return error;
+    }
+  }
+
+  ::xdp_mmap_offsets offsets{};
+  if (const auto length = xsk.socket_.unsafe_getsockopt(
+          socket_level::xdp, socket_option::xdp_mmap_offsets, any_view{&offsets});
+      not length) {
+    return length.error();
+  }
+
+  auto fill{map_ring(xsk.socket_, offsets.fr, config.fill_size, sizeof(uint64_t),
+                     XDP_UMEM_PGOFF_FILL_RING)};
+  if (not fill) {
+    return fill.error();
+  }
+
+  xsk.fill_ = xdp_fill_ring{std::move(fill.value()), offsets.fr, config.fill_size};
+
+  auto completion{map_ring(xsk.socket_, offsets.cr, config.completion_size, sizeof(uint64_t),
+                           XDP_UMEM_PGOFF_COMPLETION_RING)};
+  if (not completion) {
+    return completion.error();
+  }
+
+  xsk.completion_ =
+      xdp_completion_ring{std::move(completion.value()), offsets.cr, config.completion_size};
+
+  if (config.rx_size != 0u) {
+    auto rx{map_ring(xsk.socket_, offsets.rx, config.rx_size, sizeof(::xdp_desc),
+                     XDP_PGOFF_RX_RING)};
+    if (not rx) {
+      return rx.error();
+    }
+
+    xsk.rx_ = xdp_rx_ring{std::move(rx.value()), offsets.rx, config.rx_size};
+  }
+
+  if (config.tx_size != 0u) {
+    auto tx{map_ring(xsk.socket_, offsets.tx, config.tx_size, sizeof(::xdp_desc),
+                     XDP_PGOFF_TX_RING)};
+    if (not tx) {
+      return tx.error();
+    }
+
+    xsk.tx_ = xdp_tx_ring{std::move(tx.value()), offsets.tx, config.tx_size};
+  }
+
+  return xsk;
+}
+
+std::error_code xdp_socket::bind(const unsigned interface_index, const uint32_t queue_id,
+                                 const xdp_bind_flag flags) noexcept {
+  ::sockaddr_xdp address{};
+  address.sxdp_family = AF_XDP;
+  address.sxdp_flags = underlying_v(flags);
+  address.sxdp_ifindex = interface_index;
+  address.sxdp_queue_id = queue_id;
+
+  return socket_.unsafe_bind(reinterpret_cast<const ::sockaddr *>(&address), sizeof(address));
+}
+
+std::error_code xdp_socket::wake_tx() noexcept {
+  return ignore_busy(::sendto(static_cast<socket_fd_t>(socket_.fd()), nullptr, 0u, MSG_DONTWAIT,
+                              nullptr, 0u));
+}
+
+std::error_code xdp_socket::wake_rx() noexcept {
+  return ignore_busy(::recvfrom(static_cast<socket_fd_t>(socket_.fd()), nullptr, 0u,
+                                MSG_DONTWAIT, nullptr, nullptr));
+}
+
+result<xdp_socket_stats> xdp_socket::stats() noexcept {
+  ::xdp_statistics kernel_stats{};
+  const auto length = socket_.unsafe_getsockopt(socket_level::xdp, socket_option::xdp_statistics,
+                                                any_view{&kernel_stats});
+  if (not length) {
+    return length.error();
+  }
+
+  return xdp_socket_stats{kernel_stats.rx_dropped,
+                          kernel_stats.rx_invalid_descs,
+                          kernel_stats.tx_invalid_descs,
+                          kernel_stats.rx_ring_full,
+                          kernel_stats.rx_fill_ring_empty_descs,
+                          kernel_stats.tx_ring_empty_descs};
+}
+
+}  // namespace pposix::lnx
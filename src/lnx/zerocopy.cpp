@@ -0,0 +1,84 @@
+#include "pposix/lnx/zerocopy.hpp"
+
+#include <linux/errqueue.h>
+#include <netinet/in.h>
+
+#include "pposix/cmsg.hpp"
+#include "pposix/errno.hpp"
+
+namespace pposix::lnx {
+
+zerocopy_sender::zerocopy_sender(socket &s) noexcept : socket_{&s} {}
+
+result<zerocopy_sender> zerocopy_sender::create(socket &s) noexcept {
+  if (const auto error = s.setsockopt(socket_level::socket, socket_zerocopy::on)) {
+    return error;
+  }
+
+  return zerocopy_sender{s};
+}
+
+result<zerocopy_send> zerocopy_sender::send(const cspan<byte_cspan> buffers,
+                                            const message_flag flags) noexcept {
+  const auto sent{socket_->sendmsg(buffers, flags | message_flag::zerocopy)};
+  if (not sent) {
+    return sent.error();
+  }
+
+  // The kernel numbers every successful MSG_ZEROCOPY send on the socket, starting from zero.
+  return zerocopy_send{static_cast<std::size_t>(*sent), next_id_++};
+}
+
+result<std::size_t> zerocopy_sender::reap(span<zerocopy_completion> completions) noexcept {
+  std::size_t count{0u};
+
+  while (count < completions.length()) {
+    alignas(::cmsghdr) std::byte control[cmsg_space(sizeof(::sock_extended_err) +
+                                                    sizeof(::sockaddr_in6))];
+
+    const auto message{socket_->recvmsg(span<byte_span>{}, control,
+                                        message_flag::errqueue | message_flag::dontwait)};
+    if (not message) {
+      if (message.error() == std::errc::resource_unavailable_try_again) {
+        break;
+      }
+
+      return message.error();
+    }
+
+    bool completion_found{false};
+    for (const cmsg c : message->control()) {
+      const bool ip_error{c.level() == socket_level::ip and c.type() == IP_RECVERR};
+      const bool ipv6_error{c.level() == socket_level::ipv6 and c.type() == IPV6_RECVERR};
+      if (not ip_error and not ipv6_error) {
+        continue;
+      }
+
+      const auto error{c.value<::sock_extended_err>()};
+      if (error.ee_origin != SO_EE_ORIGIN_ZEROCOPY or error.ee_errno != 0) {
+        // Timestamps carry ENOMSG, which is not an error.
+        if (error.ee_origin != SO_EE_ORIGIN_TIMESTAMPING and error.ee_errno != 0) {
+          last_error_ = make_errno_code(std::errc{static_cast<int>(error.ee_errno)});
+        }
+
+        continue;
+      }
+
+      completion_found = true;
+
+      // ee_info and ee_data hold the first and last id of the range.
+      const zerocopy_completion completion{error.ee_info, error.ee_data,
+                                           (error.ee_code & SO_EE_CODE_ZEROCOPY_COPIED) != 0};
+      completed_ += completion.count();
+      completions.data()[count++] = completion;
+    }
+
+    if (not completion_found) {
+      ++skipped_;
+    }
+  }
+
+  return count;
+}
+
+}  // namespace pposix::lnx
@@ -1,5 +1,9 @@
 #include "pposix/mman.hpp"
 
+#include <unistd.h>
+
+#include <algorithm>
+
 #include "pposix/errno.hpp"
 #include "pposix/util.hpp"
 
@@ -23,16 +27,36 @@ std::error_code mmap_protect(mmap_d descriptor, capi::mmap_protection prot) noex
                             underlying_v(prot));
 }
 
+std::error_code mmap_advise(mmap_d descriptor, const mmap_advice advice) noexcept {
+  return PPOSIX_COMMON_CALL(::madvise, descriptor.address(), descriptor.length(),
+                            underlying_v(advice));
+}
+
 }  // namespace capi
 
-std::error_code close_mmap(mmap_d& m) noexcept {
-  return PPOSIX_COMMON_CALL(::munmap, m.address(), m.length());
+std::error_code close_mmap(const mmap_d& m) noexcept {
+  return PPOSIX_COMMON_CALL(::munmap, const_cast<void*>(m.address()), m.length());
 }
 
 mmap::mmap(const mmap_d d) noexcept : mmap_d_{d} {}
 
-std::error_code mmap::unmap() noexcept {
-  return PPOSIX_COMMON_CALL(::munmap, mmap_d_->address(), mmap_d_->length());
+std::error_code mmap::unmap() noexcept { return mmap_d_.close(); }
+
+std::error_code mmap::advise(const mmap_advice advice) noexcept {
+  return capi::mmap_advise(*mmap_d_, advice);
+}
+
+std::error_code mmap::advise(const mmap_advice advice, const std::size_t offset,
+                             const std::size_t length) noexcept {
+  if (offset >= this->length()) {
+    return make_errno_code(std::errc::invalid_argument);
+  }
+
+  const auto page_size{static_cast<std::size_t>(::sysconf(_SC_PAGESIZE))};
+  const std::size_t begin{offset - offset % page_size};
+  const std::size_t end{offset + std::min(length, this->length() - offset)};
+
+  return capi::mmap_advise(mmap_d{static_cast<std::byte *>(data()) + begin, end - begin}, advice);
 }
 
 result<shm> shm::unsafe_open(char const* const) noexcept {
@@ -1,3 +1,54 @@
 #include "pposix/signal.hpp"
 
-namespace pposix {}  // namespace pposix
+#include "pposix/errno.hpp"
+#include "pposix/util.hpp"
+
+namespace pposix {
+
+sigset::sigset() noexcept { ::sigemptyset(&signals_); }
+
+sigset sigset::filled() noexcept {
+  sigset signals{};
+  ::sigfillset(&signals.signals_);
+  return signals;
+}
+
+std::error_code sigset::add(const sig_number number) noexcept {
+  return PPOSIX_COMMON_CALL(::sigaddset, &signals_, underlying_v(number));
+}
+
+std::error_code sigset::remove(const sig_number number) noexcept {
+  return PPOSIX_COMMON_CALL(::sigdelset, &signals_, underlying_v(number));
+}
+
+std::error_code sigset::fill() noexcept { return PPOSIX_COMMON_CALL(::sigfillset, &signals_); }
+
+std::error_code sigset::clear() noexcept { return PPOSIX_COMMON_CALL(::sigemptyset, &signals_); }
+
+bool sigset::contains(const sig_number number) const noexcept {
+  return ::sigismember(&signals_, underlying_v(number)) == 1;
+}
+
+result<sigset> sigprocmask(const sigmask_how how, const sigset& signals) noexcept {
+  sigset previous{};
+  if (::sigprocmask(underlying_v(how), signals.sigset_ptr(), previous.sigset_ptr()) == -1) {
+    return current_errno_code();
+  } else {
+    return previous;
+  }
+}
+
+result<sigset> pthread_sigmask(const sigmask_how how, const sigset& signals) noexcept {
+  sigset previous{};
+
+  // pthread_sigmask reports errors through its return value instead of errno.
+  if (const int error{::pthread_sigmask(underlying_v(how), signals.sigset_ptr(),
+                                        previous.sigset_ptr())};
+      error != 0) {
+    return make_errno_code(std::errc{error});
+  } else {
+    return previous;
+  }
+}
+
+}  // namespace pposix
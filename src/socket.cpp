@@ -4,10 +4,19 @@
 #include <sys/socket.h>
 #include <unistd.h>
 
+#if PPOSIX_LINUX_EXTENSION_ENABLED
+#include <linux/sockios.h>
+#include <sys/ioctl.h>
+#endif
+
+#include <algorithm>
+
 #include "pposix/any_view.hpp"
 #include "pposix/duration.hpp"
 #include "pposix/file_descriptor.hpp"
+#include "pposix/ioctl.hpp"
 #include "pposix/result.hpp"
+#include "pposix/uio.hpp"
 #include "pposix/util.hpp"
 
 namespace pposix {
@@ -30,74 +39,89 @@ result<socket> socket::unsafe_make(socket_domain dom, socket_type typ, socket_fl
   }
 }
 
-// Set socket option
-std::error_code socket::unsafe_setsockopt(socket_level l, socket_option o,
-                                          any_cview val) noexcept {
-  return PPOSIX_COMMON_CALL(::setsockopt, static_cast<socket_fd_t>(*socket_fd_), underlying_v(l),
-                            underlying_v(o), val.data(), val.length());
-}
-
-std::error_code socket::setsockopt_int(socket_level l, socket_option o, int i) noexcept {
-  return unsafe_setsockopt(l, o, any_cview{&i});
-}
-
-std::error_code socket::setsockopt_bool(socket_level l, socket_option o, bool b) noexcept {
-  return setsockopt_int(l, o, b ? 1 : 0);
-}
-
-std::error_code socket::setsockopt(socket_level l, socket_debug d) noexcept {
-  return setsockopt_bool(l, socket_option::debug, underlying_v(d));
-}
+result<std::pair<socket, socket>> socket::unsafe_make_pair(socket_domain dom, socket_type typ,
+                                                           socket_flag flags,
+                                                           socket_protocol prot) noexcept {
+  int socks[2];
+  if (::socketpair(underlying_v(dom), underlying_v(typ) | underlying_v(flags), underlying_v(prot),
+                   socks) == -1) {
+    return current_errno_code();
+  }
 
-std::error_code socket::setsockopt(socket_level l, socket_broadcast b) noexcept {
-  return setsockopt_bool(l, socket_option::broadcast, underlying_v(b));
+  return std::pair<socket, socket>{socket{unique_socket_fd{socket_fd{socks[0]}}},
+                                   socket{unique_socket_fd{socket_fd{socks[1]}}}};
 }
 
-std::error_code socket::setsockopt(socket_level l, socket_reuseaddr r) noexcept {
-  return setsockopt_bool(l, socket_option::reuseaddr, underlying_v(r));
+std::error_code socket::unsafe_bind(const ::sockaddr *address, const socklen_t length) noexcept {
+  return PPOSIX_COMMON_CALL(::bind, static_cast<socket_fd_t>(*socket_fd_), address, length);
 }
 
-std::error_code socket::setsockopt(socket_level l, socket_keepalive k) noexcept {
-  return setsockopt_bool(l, socket_option::keepalive, underlying_v(k));
+std::error_code socket::listen(const int backlog) noexcept {
+  return PPOSIX_COMMON_CALL(::listen, static_cast<socket_fd_t>(*socket_fd_), backlog);
 }
 
-std::error_code socket::setsockopt(socket_level l, socket_linger lin) noexcept {
-  const ::linger &posix_linger = lin.get();
-  return unsafe_setsockopt(l, socket_option::linger, any_cview{&posix_linger});
+std::error_code socket::unsafe_connect(const ::sockaddr *address,
+                                       const socklen_t length) noexcept {
+  return PPOSIX_COMMON_CALL(::connect, static_cast<socket_fd_t>(*socket_fd_), address, length);
 }
 
-std::error_code socket::setsockopt(socket_level l, socket_oobinline o) noexcept {
-  return setsockopt_bool(l, socket_option::oobinline, underlying_v(o));
-}
+namespace {
 
-std::error_code socket::setsockopt(socket_level l, socket_sndbuf s) noexcept {
-  return setsockopt_int(l, socket_option::sndbuf, underlying_v(s));
+int accept_socket(const socket_fd fd, ::sockaddr *const address, socklen_t *const length,
+                  const socket_flag flags) noexcept {
+#if PPOSIX_LINUX_EXTENSION_ENABLED
+  return ::accept4(static_cast<socket_fd_t>(fd), address, length,
+                   static_cast<int>(underlying_v(flags)));
+#else
+  static_cast<void>(flags);
+  return ::accept(static_cast<socket_fd_t>(fd), address, length);
+#endif
 }
 
-std::error_code socket::setsockopt(socket_level l, socket_rcvbuf r) noexcept {
-  return setsockopt_int(l, socket_option::rcvbuf, underlying_v(r));
-}
+}  // namespace
 
-std::error_code socket::setsockopt(socket_level l, socket_dontroute d) noexcept {
-  return setsockopt_bool(l, socket_option::dontroute, underlying_v(d));
+result<socket> socket::accept(const socket_flag flags) noexcept {
+  if (const int fd{accept_socket(*socket_fd_, nullptr, nullptr, flags)}; fd == -1) {
+    return current_errno_code();
+  } else {
+    return socket{unique_socket_fd{socket_fd{fd}}};
+  }
 }
 
-std::error_code socket::setsockopt(socket_level l, socket_rcvlowat r) noexcept {
-  return setsockopt_int(l, socket_option::rcvlowat, underlying_v(r));
+result<socket> socket::accept(socket_address &peer, const socket_flag flags) noexcept {
+  *peer.length_ptr() = peer.capacity();
+  if (const int fd{accept_socket(*socket_fd_, peer.data(), peer.length_ptr(), flags)}; fd == -1) {
+    return current_errno_code();
+  } else {
+    return socket{unique_socket_fd{socket_fd{fd}}};
+  }
 }
 
-std::error_code socket::setsockopt(socket_level l, socket_rcvtimeo r) noexcept {
-  const ::timeval &val = r.get();
-  return unsafe_setsockopt(l, socket_option::rcvtimeo, any_cview{&val});
+result<socket_address> socket::local_address() const noexcept {
+  socket_address address{};
+  if (::getsockname(static_cast<socket_fd_t>(*socket_fd_), address.data(),
+                    address.length_ptr()) == -1) {
+    return current_errno_code();
+  } else {
+    return address;
+  }
 }
 
-std::error_code socket::setsockopt(socket_level l, socket_sndlowat s) noexcept {
-  return setsockopt_int(l, socket_option::sndlowat, underlying_v(s));
+result<socket_address> socket::peer_address() const noexcept {
+  socket_address address{};
+  if (::getpeername(static_cast<socket_fd_t>(*socket_fd_), address.data(),
+                    address.length_ptr()) == -1) {
+    return current_errno_code();
+  } else {
+    return address;
+  }
 }
 
-std::error_code socket::setsockopt(socket_level l, socket_sndtimeo r) noexcept {
-  const ::timeval &val = r.get();
-  return unsafe_setsockopt(l, socket_option::sndtimeo, any_cview{&val});
+// Set socket option
+std::error_code socket::unsafe_setsockopt(socket_level l, socket_option o,
+                                          any_cview val) noexcept {
+  return PPOSIX_COMMON_CALL(::setsockopt, static_cast<socket_fd_t>(*socket_fd_), underlying_v(l),
+                            underlying_v(o), val.data(), val.length());
 }
 
 // Get socket option
@@ -119,4 +143,120 @@ result<socklen_t> socket::unsafe_getsockopt(socket_level l, socket_option o,
   }
 }
 
+// Scatter/gather
+result<ssize_t> socket::sendmsg(const cspan<byte_cspan> buffers,
+                                const message_flag flags) noexcept {
+  return sendmsg(buffers, byte_cspan{}, flags);
+}
+
+result<ssize_t> socket::sendmsg(const cspan<byte_cspan> buffers, const byte_cspan control,
+                                const message_flag flags) noexcept {
+  ::msghdr message{};
+  message.msg_iov = detail::as_iovec(buffers);
+  message.msg_iovlen = buffers.length();
+  message.msg_control = const_cast<std::byte *>(control.data());
+  message.msg_controllen = control.length();
+
+  PPOSIX_COMMON_RESULT_CALL_IMPL(::sendmsg, static_cast<socket_fd_t>(*socket_fd_), &message,
+                                 underlying_v(flags))
+}
+
+result<received_message> socket::recvmsg(const span<byte_span> buffers,
+                                         const message_flag flags) noexcept {
+  return recvmsg(buffers, byte_span{}, flags);
+}
+
+result<received_message> socket::recvmsg(const span<byte_span> buffers, byte_span control,
+                                         const message_flag flags) noexcept {
+  ::msghdr message{};
+  message.msg_iov = detail::as_iovec(buffers);
+  message.msg_iovlen = buffers.length();
+  message.msg_control = control.data();
+  message.msg_controllen = control.length();
+
+  const auto bytes{
+      ::recvmsg(static_cast<socket_fd_t>(*socket_fd_), &message, underlying_v(flags))};
+  if (bytes == -1) {
+    return current_errno_code();
+  } else {
+    return received_message{static_cast<std::size_t>(bytes), message_flag{message.msg_flags},
+                            byte_cspan{control.data(), message.msg_controllen}};
+  }
+}
+
+#if PPOSIX_LINUX_EXTENSION_ENABLED
+// Batched datagrams
+result<std::size_t> socket::recv_batch(span<batch_message> messages,
+                                       const message_flag flags) noexcept {
+  const int count{::recvmmsg(static_cast<socket_fd_t>(*socket_fd_),
+                             reinterpret_cast<::mmsghdr *>(messages.data()),
+                             static_cast<unsigned>(messages.length()), underlying_v(flags),
+                             nullptr)};
+  if (count == -1) {
+    return current_errno_code();
+  } else {
+    return static_cast<std::size_t>(count);
+  }
+}
+
+result<std::size_t> socket::send_batch(span<batch_message> messages,
+                                       const message_flag flags) noexcept {
+  const int count{::sendmmsg(static_cast<socket_fd_t>(*socket_fd_),
+                             reinterpret_cast<::mmsghdr *>(messages.data()),
+                             static_cast<unsigned>(messages.length()), underlying_v(flags))};
+  if (count == -1) {
+    return current_errno_code();
+  } else {
+    return static_cast<std::size_t>(count);
+  }
+}
+
+// Connection statistics
+result<tcp_info_snapshot> tcp_info_snapshot::read(const socket_fd fd) noexcept {
+  tcp_info_snapshot snapshot{};
+  socklen_t length{sizeof(snapshot.info_)};
+  if (::getsockopt(static_cast<socket_fd_t>(fd), underlying_v(socket_level::tcp),
+                   underlying_v(socket_option::tcp_info), &snapshot.info_, &length) == -1) {
+    return current_errno_code();
+  }
+
+  snapshot.length_ = length;
+  return snapshot;
+}
+
+std::size_t sample_tcp_info(const cspan<socket_fd> sockets,
+                            span<tcp_info_snapshot> snapshots) noexcept {
+  const std::size_t count{std::min(sockets.length(), snapshots.length())};
+
+  std::size_t read{0u};
+  for (std::size_t i = 0u; i < count; ++i) {
+    if (auto snapshot{tcp_info_snapshot::read(sockets.data()[i])}) {
+      snapshots.data()[i] = *snapshot;
+      ++read;
+    } else {
+      snapshots.data()[i] = tcp_info_snapshot{};
+    }
+  }
+
+  return read;
+}
+
+namespace {
+
+result<int> socket_queue(const socket_fd fd, const ioctl_int request) noexcept {
+  int bytes{};
+  return result_map<int>(
+      ioctl(raw_fd{static_cast<raw_fd_t>(fd)}, ioctl_request{request}, any_view{&bytes}),
+      [&](ioctl_int /*ignored*/) noexcept { return bytes; });
+}
+
+}  // namespace
+
+result<int> socket::input_queue() const noexcept { return socket_queue(fd(), SIOCINQ); }
+
+result<int> socket::output_queue() const noexcept { return socket_queue(fd(), SIOCOUTQ); }
+
+result<int> socket::unsent_queue() const noexcept { return socket_queue(fd(), SIOCOUTQNSD); }
+#endif
+
 }  // namespace pposix
@@ -0,0 +1,164 @@
+// Sends UDP datagrams over loopback with software timestamping enabled on both ends and prints
+// the latency distribution between the kernel's stamps and the application's clock reads:
+//  - tx: from reading the clock before sendmsg to the kernel's "sent" transmit stamp;
+//  - rx: from the kernel's receive stamp to reading the clock after recvmsg returned.
+//
+// Usage: pposix_timestamp_latency [count]
+
+#include <time.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <iterator>
+#include <vector>
+
+#include "pposix/address.hpp"
+#include "pposix/lnx/timestamping.hpp"
+#include "pposix/socket.hpp"
+
+using namespace pposix;
+
+namespace {
+
+int64_t to_ns(const ::timespec &t) noexcept {
+  return static_cast<int64_t>(t.tv_sec) * 1'000'000'000 + t.tv_nsec;
+}
+
+int64_t now_ns() noexcept {
+  ::timespec t{};
+  ::clock_gettime(CLOCK_REALTIME, &t);
+  return to_ns(t);
+}
+
+int fail(const char *what, const std::error_code error) {
+  std::fprintf(stderr, "%s: %s\n", what, error.message().c_str());
+  return EXIT_FAILURE;
+}
+
+void print_distribution(const char *name, std::vector<int64_t> &samples) {
+  if (samples.empty()) {
+    std::printf("%s: no samples\n", name);
+    return;
+  }
+
+  std::sort(samples.begin(), samples.end());
+  const auto at = [&](const double q) {
+    return samples[static_cast<std::size_t>(q * static_cast<double>(samples.size() - 1u))];
+  };
+
+  std::printf("%s (%zu samples, ns): min %lld p50 %lld p90 %lld p99 %lld p99.9 %lld max %lld\n",
+              name, samples.size(), static_cast<long long>(samples.front()),
+              static_cast<long long>(at(0.5)), static_cast<long long>(at(0.9)),
+              static_cast<long long>(at(0.99)), static_cast<long long>(at(0.999)),
+              static_cast<long long>(samples.back()));
+}
+
+}  // namespace
+
+int main(int argc, char **argv) {
+  const std::size_t count{argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 100'000u};
+
+  auto receiver{socket::unsafe_make(socket_domain::inet, socket_type::dgram, socket_flag::closexec,
+                                    socket_protocol::udp)};
+  auto sender{socket::unsafe_make(socket_domain::inet, socket_type::dgram, socket_flag::closexec,
+                                  socket_protocol::udp)};
+  if (not receiver or not sender) {
+    return fail("socket", receiver ? sender.error() : receiver.error());
+  }
+
+  if (const auto error{receiver->bind(inet_address::loopback(0u))}) {
+    return fail("bind", error);
+  }
+
+  const auto address{receiver->local_address()};
+  if (not address) {
+    return fail("getsockname", address.error());
+  }
+
+  if (const auto error{sender->connect(*address)}) {
+    return fail("connect", error);
+  }
+
+  if (const auto error{receiver->setsockopt(socket_timestamping::rx_software |
+                                            socket_timestamping::software)}) {
+    return fail("SO_TIMESTAMPING (rx)", error);
+  }
+
+  if (const auto error{sender->setsockopt(
+          socket_timestamping::tx_software | socket_timestamping::software |
+          socket_timestamping::opt_id | socket_timestamping::opt_tsonly)}) {
+    return fail("SO_TIMESTAMPING (tx)", error);
+  }
+
+  // With opt_id the n-th send is stamped with id n, so the send times are indexed by it.
+  std::vector<int64_t> send_times(count);
+  std::vector<int64_t> tx_latency{};
+  std::vector<int64_t> rx_latency{};
+  tx_latency.reserve(count);
+  rx_latency.reserve(count);
+
+  lnx::tx_timestamp stamps[64];
+  lnx::tx_timestamp_skipped skipped{};
+  const auto collect_tx = [&]() -> std::error_code {
+    for (;;) {
+      const auto read{lnx::read_tx_timestamps(*sender, stamps, skipped)};
+      if (not read) {
+        return read.error();
+      }
+
+      for (std::size_t i{0u}; i < *read; ++i) {
+        const lnx::tx_timestamp &stamp{stamps[i]};
+        if (stamp.type == lnx::tx_timestamp_type::sent and stamp.id < count) {
+          tx_latency.push_back(to_ns(stamp.time) - send_times[stamp.id]);
+        }
+      }
+
+      if (*read < std::size(stamps)) {
+        return {};
+      }
+    }
+  };
+
+  std::byte payload[64]{};
+  const byte_cspan send_buffers[]{payload};
+  std::byte received[64];
+  byte_span receive_buffers[]{received};
+  alignas(::cmsghdr) std::byte control[lnx::timestamp_control_space];
+
+  for (std::size_t i{0u}; i < count; ++i) {
+    send_times[i] = now_ns();
+    if (const auto sent{sender->sendmsg(send_buffers, message_flag::none)}; not sent) {
+      return fail("sendmsg", sent.error());
+    }
+
+    const auto message{receiver->recvmsg(receive_buffers, control, message_flag::none)};
+    const int64_t received_at{now_ns()};
+    if (not message) {
+      return fail("recvmsg", message.error());
+    }
+
+    if (const auto stamp{lnx::rx_timestamps(message->control()).software}) {
+      rx_latency.push_back(received_at - to_ns(*stamp));
+    }
+
+    if (const auto error{collect_tx()}) {
+      return fail("read_tx_timestamps", error);
+    }
+  }
+
+  // On loopback the stamps are queued before the datagram is delivered, so none are outstanding.
+  if (const auto error{collect_tx()}) {
+    return fail("read_tx_timestamps", error);
+  }
+
+  print_distribution("tx app -> kernel sent", tx_latency);
+  print_distribution("rx kernel -> app", rx_latency);
+  if (skipped.count != 0u) {
+    std::printf("skipped %llu other error queue messages\n",
+                static_cast<unsigned long long>(skipped.count));
+  }
+
+  return EXIT_SUCCESS;
+}